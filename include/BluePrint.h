@@ -7,9 +7,13 @@
 #include <thread>
 #include <atomic>
 #include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
 #include <algorithm>
 #include <map>
 #include <memory>
+#include <cstring>
+#include <cstdio>
 #include <imgui_json.h>
 //#include <variant.hpp>  // variant for C++14
 #include <variant>    // variant for C++17
@@ -28,6 +32,7 @@
 #define BP_ERR_PIN_LINK     -6
 #define BP_ERR_DOC_LOAD     -7
 #define BP_ERR_GROUP_LOAD   -8
+#define BP_ERR_BINARY_LOAD  -9
 
 typedef uint32_t ID_TYPE;
 typedef uint32_t VERSION_TYPE;
@@ -89,6 +94,7 @@ inline uint32_t fnv1a_hash_32(string str)
 
 struct NodeRegistry;
 struct Node;
+struct GroupTemplate;
 struct Context;
 enum class StepResult
 {
@@ -125,6 +131,10 @@ struct ContextMonitor
 
     virtual void OnPreStep(Context& context) {}
     virtual void OnPostStep(Context& context) {}
+
+    // around Node::EvaluatePin(), called without g_Mutex and maybe from node threads
+    virtual void OnPreEvaluate(const Context& context, const Pin& pin) {}
+    virtual void OnPostEvaluate(const Context& context, const Pin& pin) {}
 };
 
 struct IMGUI_API Context
@@ -277,6 +287,164 @@ public:
 };
 # pragma endregion
 
+# pragma region JsonWriter
+// Streaming json writer, text goes to file or string buffer directly without building a DOM
+struct IMGUI_API JsonWriter
+{
+    JsonWriter(FILE* file, int indent = 4);
+    JsonWriter(std::string& buffer, int indent = 4);
+    ~JsonWriter() { Flush(); }
+
+    void BeginObject();
+    void EndObject();
+    void BeginArray();
+    void EndArray();
+    void Key(const std::string& key);
+    void String(const std::string& str);
+    void Number(double number);
+    void Boolean(bool boolean);
+    void Null();
+    void Value(const imgui_json::value& value);    // write small DOM fragment
+    bool Flush();
+    bool IsGood() const { return m_Good; }
+
+private:
+    void BeginValue();
+    void NewLine();
+    void WriteEscaped(const std::string& str);
+
+    FILE*               m_File      {nullptr};
+    std::string*        m_Buffer    {nullptr};
+    std::string         m_Chunk;
+    std::vector<bool>   m_HasItem;  // per open object/array
+    int                 m_Indent    {4};
+    bool                m_AfterKey  {false};
+    bool                m_Good      {true};
+};
+# pragma endregion
+
+# pragma region Binary
+// Binary blueprint file, all fields are stored in host byte order (little endian)
+//   header:        magic, version, generator state, node count
+//   node record:   type id, type name, record kind, payload size, payload
+// payload of BP_BINARY_RECORD_VALUE is encoded json which is same as Node::Save, it is
+// decoded into a json value of that node only, other record kinds are reserved
+#define BP_BINARY_MAGIC             0x4E425042  // "BPBN"
+#define BP_BINARY_VERSION           1
+#define BP_BINARY_RECORD_VALUE      0
+
+struct IMGUI_API BinaryWriter
+{
+    void Write(const void* data, size_t size);
+    template <typename T>
+    void Write(const T& value) { Write(&value, sizeof(T)); }
+    void WriteString(const std::string& str);
+    void WriteValue(const imgui_json::value& value);
+
+    template <typename T>
+    void Patch(size_t offset, const T& value) { memcpy(m_Buffer.data() + offset, &value, sizeof(T)); }
+
+    size_t Size() const { return m_Buffer.size(); }
+    const uint8_t* Data() const { return m_Buffer.data(); }
+    bool Save(std::string path) const;
+
+    std::vector<uint8_t> m_Buffer;
+};
+
+struct IMGUI_API BinaryReader
+{
+    BinaryReader(const void* data, size_t size)
+        : m_Ptr((const uint8_t*)data), m_End((const uint8_t*)data + size) {}
+
+    bool Read(void* data, size_t size);
+    template <typename T>
+    bool Read(T& value) { return Read(&value, sizeof(T)); }
+    bool ReadString(std::string& str);
+    bool ReadValue(imgui_json::value& value);
+    bool Skip(size_t size);
+    BinaryReader SubReader(size_t size) const;  // reader of next size bytes, parent isn't advanced
+
+    size_t Remain() const { return m_End - m_Ptr; }
+    const uint8_t* Current() const { return m_Ptr; }
+
+private:
+    bool ReadValue(imgui_json::value& value, int depth);
+
+    const uint8_t*  m_Ptr   {nullptr};
+    const uint8_t*  m_End   {nullptr};
+};
+
+// read only file mapping, falls back to reading whole file where mmap isn't available
+struct IMGUI_API MappedFile
+{
+    MappedFile() = default;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    ~MappedFile() { Close(); }
+
+    bool Open(std::string path);
+    void Close();
+    const uint8_t* Data() const { return m_Data; }
+    size_t Size() const { return m_Size; }
+
+private:
+    const uint8_t*          m_Data      {nullptr};
+    size_t                  m_Size      {0};
+    bool                    m_Mapped    {false};
+    std::vector<uint8_t>    m_Buffer;
+};
+# pragma endregion
+
+// Node execution time in microseconds, percentiles are upper bounds of histogram buckets
+struct LatencyStats
+{
+    uint64_t    m_Count {0};
+    uint64_t    m_P50   {0};
+    uint64_t    m_P95   {0};
+    uint64_t    m_P99   {0};
+    uint64_t    m_Max   {0};
+};
+
+# pragma region BPArena
+// Memory of nodes and pins created for one BP, see Node/Pin operator new(size_t, BP*).
+// A freed object goes to a free list of its size and is reused, blocks are released together
+// by BP::Clear() once nothing lives in them. Arena stays alive after its BP while objects are left.
+struct IMGUI_API BPArena
+{
+    static constexpr size_t BLOCK_SIZE = 256 * 1024;
+    static constexpr size_t MAX_OBJECT_SIZE = 16 * 1024;    // bigger objects go to heap
+
+    static void* Allocate(BPArena* arena, size_t size);     // heap if arena is null or arenas are disabled
+    static void  Free(void* ptr);                           // anything returned by Allocate
+    static void  SetEnabled(bool enable);                   // off sends new objects to heap, e.g. for address sanitizer
+
+    void   Trim();                  // release blocks if no object is left
+    void   Detach();                // owner is gone, delete now or with last object
+    size_t GetLiveCount() const;
+    size_t GetBlockCount() const;
+
+private:
+    struct Header
+    {
+        BPArena*    m_Arena;
+        size_t      m_Size;
+    };
+    static constexpr size_t HEADER_SIZE = (sizeof(Header) + alignof(std::max_align_t) - 1) & ~(alignof(std::max_align_t) - 1);
+
+    void* Take(size_t size);
+    bool  Put(void* slot, size_t size);         // true if arena has to be deleted
+
+    std::vector<std::unique_ptr<char[]>>    m_Blocks;
+    char*                                   m_Cursor {nullptr};
+    size_t                                  m_Left {0};
+    std::unordered_map<size_t, void*>       m_FreeLists;    // by slot size, next free slot is stored in slot
+    size_t                                  m_Live {0};
+    bool                                    m_Detached {false};
+    mutable std::mutex                      m_Mutex;
+    static std::atomic<bool>                s_Enabled;
+};
+# pragma endregion
+
 # pragma region BP
 struct IMGUI_API BP
 {
@@ -307,6 +475,7 @@ struct IMGUI_API BP
     void ForgetPin(Pin* pin);
 
     void Clear();
+    BPArena* GetArena();                // created on first use
 
     span<      Node*>       GetNodes();
     span<const Node* const> GetNodes() const;
@@ -317,6 +486,9 @@ struct IMGUI_API BP
             Node* FindNode(ID_TYPE nodeId);
     const   Node* FindNode(ID_TYPE nodeId) const;
 
+    bool GetNodeLatency(ID_TYPE nodeId, LatencyStats& stats) const; // false if node doesn't exist, samples add up over runs until ResetLatency()
+    void ResetLatency();                                // only way to drop latency samples, runs keep them
+
             Pin* FindPin(ID_TYPE pinId);
     const   Pin* FindPin(ID_TYPE pinId) const;
 
@@ -357,10 +529,26 @@ struct IMGUI_API BP
 
     int Load(const imgui_json::value& value);
     int Import(const imgui_json::value& value, ImVec2 pos);
-    void Save(imgui_json::value& value) const;
+    int Import(std::string path, ImVec2 pos);           // group file is parsed once and reused until it changes on disk
+    void Save(imgui_json::value& value);                // saving refreshes cached node records, so it is not const
 
     int Load(std::string path);
-    bool Save(std::string path) const;
+    bool Save(std::string path);
+
+    void Save(JsonWriter& writer);                      // stream nodes one by one, clean nodes are written from their cached record
+    void MarkDirty();                                   // drop cached node records, next save serializes every node again
+    void NoteEdit(Node* node);                          // Node::MarkDirty, node is listed once until next TakeEditedNodes()
+    std::vector<ID_TYPE> TakeEditedNodes();             // nodes marked dirty since last call, may hold removed nodes
+    const imgui_json::value& SaveNode(Node* node, imgui_json::value& scratch); // node record with type info, cached while node is clean, nodes which don't report edits are written into scratch
+    void SaveState(imgui_json::value& value) const;     // "state" member of saved blueprint
+
+    int LoadBinary(BinaryReader& reader);
+    void SaveBinary(BinaryWriter& writer) const;
+    int LoadBinary(std::string path);                   // file is memory mapped, nodes are loaded from per node json values, never from a DOM of whole file
+    bool SaveBinary(std::string path) const;
+    static bool IsBinary(const void* data, size_t size);
+    static int JsonToBinary(const imgui_json::value& value, BinaryWriter& writer);
+    static int BinaryToJson(BinaryReader& reader, imgui_json::value& value);
 
     ID_TYPE MakeNodeID(Node* node);
     ID_TYPE MakePinID(Pin* pin);
@@ -370,12 +558,17 @@ struct IMGUI_API BP
     Pin * GetPinFromID(ID_TYPE pinid);
     const Pin * GetPinFromID(ID_TYPE pinid) const;
 
+    uint64_t GetLinkRevision() const { return m_LinkRevision; } // changes with every link edit, pin creation or removal
+    void     TouchLinks() { m_LinkRevision++; }                 // for code which edits m_Link/m_LinkFrom/m_Flags directly
+    const Pin* ResolveLink(const Pin& pin) const;               // provider of pin with group bridge/shadow pins skipped, null if unlinked or chain is broken
+
     void SetTimeStamp(int64_t time_stamp) { m_TimeStamp = time_stamp; }
     void SetDurtion(int64_t durtion) { m_Duration = durtion; }
     int64_t GetTimeStamp() { return m_TimeStamp; }
     int64_t GetDurtion() { return m_Duration; }
 
-    std::vector<Pin*> FindPinsLinkedTo(const Pin& pin) const;
+    std::vector<Pin*> FindPinsLinkedTo(const Pin& pin) const;  // receivers linked to pin, O(links of pin)
+    void UpdateLink(Pin& receiver, ID_TYPE oldLink);            // Pin::LinkTo/Unlink, m_Link of receiver moved from oldLink
 
     void OnContextRunDone();
     void OnContextPause();
@@ -386,17 +579,81 @@ struct IMGUI_API BP
     void OnContextStepCurrent();
 
 private:
+    int Import(const GroupTemplate& tmpl, ImVec2 pos);  // GroupTemplate is internal to group node
     void ResetState();
     Node * CreateDummyNode(const imgui_json::value& value, BP* blueprint);
+    Node * LoadNode(ID_TYPE typeId, const imgui_json::value& nodeValue);  // create node from json, Dummy node replaces unknown or broken one
+    int CloneFrom(const BP& other);                                       // structural copy, nodes without Clone() go through json
+    template <typename T>
+    T* FindIndexed(std::unordered_map<ID_TYPE, T*>& index, bool& valid, uint64_t& revision, const std::vector<T*>& items, ID_TYPE id) const;
+    void InvalidateIndex();
+    void RebuildFlatLinks() const;
+    std::shared_lock<std::shared_mutex> LockPinTable() const;            // table is up to date while lock is held
+    std::shared_lock<std::shared_mutex> LockLinkIndex() const;           // same for m_LinkIndex
+    void EditLinkIndex(Pin* receiver, ID_TYPE oldLink, ID_TYPE newLink); // moves m_LinkRevision, index follows if it was current
 
     static shared_ptr<NodeRegistry>        s_NodeRegistry;
     static shared_ptr<PinExRegistry>       s_PinExRegistry;
     IDGenerator                     m_Generator;
     std::vector<Node*>              m_Nodes;
     std::vector<Pin*>               m_Pins;
+    BPArena*                        m_Arena {nullptr};
     Context                         m_Context;
     bool                            m_StyleLight {false};
     bool                            m_IsOpen {false};
+    std::atomic<uint64_t>           m_LinkRevision {0};
+    std::atomic<uint64_t>           m_EditEpoch {1};
+    std::vector<ID_TYPE>            m_EditedNodes;
+    std::mutex                      m_EditMutex;
+
+    // ID lookup, entries point to live objects only, any removal drops whole index.
+    // IDs may still change after creation (Load, group import), so a hit is checked against m_ID
+    // and a miss is trusted only while m_LinkRevision is the one index was built at.
+    mutable std::unordered_map<ID_TYPE, Node*>  m_NodeIndex;
+    mutable std::unordered_map<ID_TYPE, Pin*>   m_PinIndex;
+    mutable bool                                m_NodeIndexValid {false};
+    mutable bool                                m_PinIndexValid {false};
+    mutable uint64_t                            m_NodeIndexRevision {0};
+    mutable uint64_t                            m_PinIndexRevision {0};
+    mutable std::shared_mutex                   m_IndexMutex;
+
+    // Execution view of links, chains through group bridge/shadow pins collapsed to the real provider.
+    // Rebuilt when m_LinkRevision moves, entry is only used while pin still links to m_Link.
+    struct FlatLink
+    {
+        ID_TYPE m_Link      {0};
+        Pin*    m_Provider  {nullptr};
+    };
+    mutable std::unordered_map<ID_TYPE, FlatLink>   m_FlatLinks;
+    mutable uint64_t                                m_FlatLinkRevision {static_cast<uint64_t>(-1)};
+    mutable std::shared_mutex                       m_FlatLinkMutex;
+
+    // Link graph of m_Pins as parallel arrays, scans read a few dense columns instead of whole Pin objects.
+    // Row i is m_Pins[i] at build time, table is rebuilt when m_LinkRevision moves.
+    struct PinTable
+    {
+        std::vector<ID_TYPE>                m_ID;
+        std::vector<ID_TYPE>                m_Link;
+        std::vector<ID_TYPE>                m_Flags;
+        std::vector<PinType>                m_Type;
+        std::vector<Node*>                  m_Node;
+        std::vector<Pin*>                   m_Pin;
+        std::unordered_map<ID_TYPE, uint32_t> m_Row;    // first row of ID, same pin GetPinFromID() finds
+        uint64_t                            m_Revision {static_cast<uint64_t>(-1)};
+    };
+    mutable PinTable                                m_PinTable;
+    mutable std::shared_mutex                       m_PinTableMutex;
+
+    // Reverse links, provider pin ID -> receivers linked to it, same relation LinkTo/Unlink keep in m_LinkFrom.
+    // LinkTo/Unlink, pin creation and ForgetPin edit it in place, any other edit goes through TouchLinks()
+    // and the index is rebuilt from pin table on next query.
+    struct LinkIndex
+    {
+        std::unordered_map<ID_TYPE, std::vector<Pin*>>  m_Receivers;
+        uint64_t                                        m_Revision {static_cast<uint64_t>(-1)};
+    };
+    mutable LinkIndex                               m_LinkIndex;
+    mutable std::shared_mutex                       m_LinkIndexMutex;
 
     // Node Time info
     int64_t                         m_TimeStamp {-1};
@@ -404,6 +661,40 @@ private:
 };
 # pragma endregion
 
+# pragma region BPInstancePool
+// Loaded blueprint is kept as a template that is never run, every clip which uses the
+// same filter file gets an instance copied from it structurally. Released instances are
+// restored to template pin values and handed out again without copying.
+struct IMGUI_API BPInstancePool
+{
+    BPInstancePool() = default;
+    BPInstancePool(const BPInstancePool&) = delete;
+    BPInstancePool& operator=(const BPInstancePool&) = delete;
+    ~BPInstancePool();
+
+    int Load(std::string path);                         // drop all instances and load new template
+    int Load(const imgui_json::value& value);
+    const BP& GetTemplate() const { return m_Template; }
+
+    BP*  Acquire();                                     // instance owned by pool, valid until Release() or pool is destroyed
+    void Release(BP* instance);                         // stop instance and restore template node state, rebuilt when it no longer matches template
+    void Reserve(size_t count);                         // prebuild instances so Acquire() only pops from free list
+    void Clear();                                       // deletes acquired instances too, not to be called while clips run
+
+    size_t GetInstanceCount() const;
+    size_t GetFreeCount() const;
+
+private:
+    BP*  CreateInstance();
+    void RestoreInstance(BP* instance);
+
+    BP                              m_Template;
+    std::vector<BP*>                m_Instances;
+    std::vector<BP*>                m_FreeInstances;
+    mutable std::mutex              m_Mutex;
+};
+# pragma endregion
+
 } // namespace BluePrint
 
 # define VERSION_MAJOR(v)   ((v & 0xFF000000) >> 24)
@@ -432,7 +723,7 @@ IMGUI_API void GetVersion(int& major, int& minor, int& patch, int& build);
             node_type, \
             node_style, \
             node_catalog, \
-            [](::BluePrint::BP* blueprint) -> ::BluePrint::Node* { return new type(blueprint); } \
+            [](::BluePrint::BP* blueprint) -> ::BluePrint::Node* { return new (blueprint) type(blueprint); } \
         }; \
     } \
     \
@@ -456,7 +747,7 @@ IMGUI_API void GetVersion(int& major, int& minor, int& patch, int& build);
             node_type, \
             node_style, \
             node_catalog, \
-            [](::BluePrint::BP* blueprint) -> ::BluePrint::Node* { return new type(blueprint); } \
+            [](::BluePrint::BP* blueprint) -> ::BluePrint::Node* { return new (blueprint) type(blueprint); } \
         }; \
     } \
     \
@@ -492,7 +783,7 @@ IMGUI_API void GetVersion(int& major, int& minor, int& patch, int& build);
             node_type, \
             node_style, \
             node_catalog, \
-            [](::BluePrint::BP* blueprint) -> ::BluePrint::Node* { return new BluePrint::type(blueprint); } \
+            [](::BluePrint::BP* blueprint) -> ::BluePrint::Node* { return new (blueprint) BluePrint::type(blueprint); } \
         ); \
     } \
     \
@@ -521,7 +812,7 @@ IMGUI_API void GetVersion(int& major, int& minor, int& patch, int& build);
             node_type, \
             node_style, \
             node_catalog, \
-            [](::BluePrint::BP* blueprint) -> ::BluePrint::Node* { return new BluePrint::type(blueprint); } \
+            [](::BluePrint::BP* blueprint) -> ::BluePrint::Node* { return new (blueprint) BluePrint::type(blueprint); } \
         ); \
     } \
     \
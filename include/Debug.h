@@ -11,16 +11,40 @@ enum class LogLevel: int32_t
     Debug,
     Warning,
     Error,
+    Off,        // nothing is logged
 };
 
-# define LOGV(...)
-# define LOGD(...)
-# define LOGI(...)
-# define LOGW(...)
-# define LOGE(...)
+// LOGx statements below current level cost one relaxed load and a compare
+# define BP_LOG(level, ...) do { if (BluePrint::Logger::IsEnabled(level)) BluePrint::Logger::Write(level, __VA_ARGS__); } while (0)
+# define LOGV(...) BP_LOG(LogLevel::Verbose, __VA_ARGS__)
+# define LOGD(...) BP_LOG(LogLevel::Debug, __VA_ARGS__)
+# define LOGI(...) BP_LOG(LogLevel::Info, __VA_ARGS__)
+# define LOGW(...) BP_LOG(LogLevel::Warning, __VA_ARGS__)
+# define LOGE(...) BP_LOG(LogLevel::Error, __VA_ARGS__)
 
 namespace BluePrint
 {
+// Asynchronous logger behind LOGx macros. Message is formatted on calling thread into a lock-free
+// ring buffer, a background thread writes it to console and log file. Calling thread never waits,
+// message is dropped when ring is full.
+struct IMGUI_API Logger
+{
+    static constexpr size_t MESSAGE_SIZE = 256;     // longer messages are truncated
+    static constexpr size_t RING_SIZE = 4096;       // messages waiting for writer, power of 2
+
+    static bool     IsEnabled(LogLevel level) { return static_cast<int32_t>(level) >= s_Level.load(std::memory_order_relaxed); }
+    static void     SetLevel(LogLevel level);       // Warning by default
+    static LogLevel GetLevel();
+    static void     SetConsole(bool enable);        // stderr, on by default
+    static bool     SetFile(std::string path);      // append to file, empty path closes it
+    static void     Flush();                        // wait until queued messages are written
+    static size_t   DroppedCount();                 // messages lost to full ring
+    static void     Write(LogLevel level, const char* format, ...) IM_FMTARGS(2);
+
+private:
+    static std::atomic<int32_t> s_Level;
+};
+
 struct BluePrintUI;
 struct DebugOverlay:
     private ContextMonitor
@@ -56,4 +80,77 @@ private:
     ImDrawListSplitter m_Splitter;
 };
 
+// Records blueprint execution as Chrome trace events, written file loads in Perfetto or chrome://tracing.
+// Node runs, group boundaries and data pin evaluations are slices, flow transitions are arrows between them.
+// Every thread records into its own ring buffer, oldest events are overwritten when it is full. Slices are
+// written as complete events, so a begin or end which lost its other half to the ring is left out.
+struct ExecutionTracer:
+    private ContextMonitor
+{
+    ExecutionTracer(size_t capacity = 1 << 16);     // events kept per thread
+    ~ExecutionTracer();
+
+    void Attach(BP* blueprint);     // goes in front of current monitor, which still gets every callback
+    void Detach();                  // gives monitor slot back, call before blueprint or previous monitor goes away
+    void Clear();                   // drop recorded events, not while blueprint is running
+    size_t EventCount() const;
+    bool Write(std::string path, const BP* blueprint = nullptr) const;  // names are taken from blueprint, attached one by default
+
+private:
+    enum class EventType : uint8_t
+    {
+        NodeBegin,
+        NodeEnd,
+        GroupBegin,
+        GroupEnd,
+        EvalBegin,
+        EvalEnd,
+        FlowOut,
+        FlowIn,
+    };
+
+    struct Event
+    {
+        int64_t     m_Time  {0};
+        ID_TYPE     m_ID    {0};    // node, group or pin
+        ID_TYPE     m_Flow  {0};    // flow id of flow events
+        EventType   m_Type  {EventType::NodeBegin};
+    };
+
+    struct Ring
+    {
+        std::vector<Event>  m_Events;
+        uint64_t            m_Written {0};
+        int                 m_Thread  {0};
+    };
+
+    Ring* GetRing();
+    void Record(EventType type, ID_TYPE id, ID_TYPE flow = 0);
+    void EnterGroups(const Node* node);
+    void LeaveGroups(size_t keep);
+
+    void OnStart(Context& context) override;
+    void OnError(Context& context) override;
+    void OnDone(Context& context) override;
+    void OnPause(Context& context) override;
+    void OnResume(Context& context) override;
+    void OnStepNext(Context& context) override;
+    void OnStepCurrent(Context& context) override;
+    void OnPreStep(Context& context) override;
+    void OnPostStep(Context& context) override;
+    void OnPreEvaluate(const Context& context, const Pin& pin) override;
+    void OnPostEvaluate(const Context& context, const Pin& pin) override;
+
+    BP*                                 m_Blueprint {nullptr};
+    ContextMonitor*                     m_Next {nullptr};
+    size_t                              m_Capacity;
+    std::atomic<uint64_t>               m_Session {0};      // threads register a new ring when it changes
+    mutable std::mutex                  m_RingMutex;
+    std::vector<std::unique_ptr<Ring>>  m_Rings;
+    std::vector<ID_TYPE>                m_Groups;           // groups around last stepped node, outermost first
+    ID_TYPE                             m_Flow {0};         // flow left by last step, 0 if none
+    ID_TYPE                             m_NextFlow {1};
+    std::atomic<bool>                   m_Stepping {false}; // evaluations are recorded while a node runs
+};
+
 }
\ No newline at end of file
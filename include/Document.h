@@ -4,9 +4,15 @@
 #include <imgui_json.h>
 #include <BluePrint.h>
 #include <vector>
+#include <deque>
 #include <map>
+#include <set>
+#include <unordered_map>
 #include <memory>
 #include <string>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
 #include <stdint.h>
 
 namespace ed = ax::NodeEditor;
@@ -32,8 +38,9 @@ struct IMGUI_API Document
 
     struct UndoState
     {
-        string          m_Name;
-        DocumentState   m_State;
+        string              m_Name;
+        imgui_json::value   m_Delta;    // structural patch from the state after this step to the state before it
+        size_t              m_Size = 0; // approximate memory held by m_Delta
     };
 
     struct UndoTransaction
@@ -58,7 +65,6 @@ struct IMGUI_API Document
     private:
         string                      m_Name;
         Document*                   m_Document = nullptr;
-        UndoState                   m_State;
         ImGuiTextBuffer             m_Actions;
         bool                        m_HasBegan = false;
         bool                        m_IsDone = false;
@@ -81,11 +87,19 @@ struct IMGUI_API Document
     int  Import(std::string path, ImVec2 pos);
     bool Save(std::string path) const;
     bool Save() const;
+    static bool Save(std::string path, const DocumentState& state, const imgui_json::value& view); // written to temp file and renamed over path
 
     bool Undo();
     bool Redo();
+    void PushUndo(UndoState&& state);       // clear redo and drop oldest steps over memory limit
+    void TrimUndo();
+    void ClearUndo();
 
     DocumentState BuildDocumentState();
+    bool UpdateDocumentState(imgui_json::value* inverse);                           // patch state with changed nodes and editor state, inverse gets delta back, false if nothing changed
+    DocumentState& EditDocumentState();                                             // unshare state before changing it in place
+    const DocumentState& GetDocumentState() const;
+    shared_ptr<const DocumentState> GetStateSnapshot() const;                       // no copy, state is replaced, never changed while shared
     void ApplyState(const DocumentState& state);
     void ApplyState(const NavigationState& state);
 
@@ -106,18 +120,95 @@ struct IMGUI_API Document
     string                  m_Name;
     string                  m_CatalogFilter;
     bool                    m_IsModified = false;
-    vector<UndoState>       m_Undo;
-    vector<UndoState>       m_Redo;
+    std::deque<UndoState>   m_Undo;
+    std::deque<UndoState>   m_Redo;
+    size_t                  m_UndoMemory = 0;
+    size_t                  m_UndoMemoryLimit = 64 * 1024 * 1024;  // bytes of undo and redo deltas, 0 is unlimited
+    uint64_t                m_StateRevision = 0;                   // bumped every time m_DocumentState changes
 
-    DocumentState           m_DocumentState;
+    mutable shared_ptr<DocumentState> m_DocumentState = std::make_shared<DocumentState>();  // shared with snapshots, read through GetDocumentState()
     NavigationState         m_NavigationState;
 
+    // change set since last state update
+    std::vector<ID_TYPE>    m_NodeOrder;                     // node IDs of records held in m_DocumentState, in blueprint order
+    std::unordered_map<ID_TYPE, size_t> m_RecordIndex;       // node ID to record position
+    std::vector<ID_TYPE>    m_UncachedNodes;                 // nodes which don't report edits, compared on every update
+    std::set<ID_TYPE>       m_ChangedNodeStates;             // nodes reported by editor
+    bool                    m_SelectionChanged = false;
+    bool                    m_StateSynced = false;           // m_NodeOrder matches state, otherwise next update rebuilds whole state
+
+    // updates made while autosave holds m_DocumentState, applied once it is released or state is read
+    struct PendingState
+    {
+        std::unordered_map<ID_TYPE, imgui_json::value>  m_Records;      // replaced node records
+        std::map<std::string, imgui_json::value>        m_NodeStates;   // replaced editor node states, null is removed
+        imgui_json::value                               m_Selection;
+        imgui_json::value                               m_BlueprintState;
+        bool                                            m_HasSelection = false;
+        bool                                            m_HasBlueprintState = false;
+
+        bool empty() const { return m_Records.empty() && m_NodeStates.empty() && !m_HasSelection && !m_HasBlueprintState; }
+    };
+    mutable PendingState    m_Pending;
+
     UndoTransaction*        m_MasterTransaction = nullptr;
 
     shared_ptr<UndoTransaction> m_SaveTransaction = nullptr;
 
     BP                      m_Blueprint;
     void *                  m_UserData {nullptr};
+
+private:
+    bool FallbackUpdate(imgui_json::value* inverse);
+    bool UpdateNodeRecords(span<Node*> nodes, imgui_json::value& delta); // same nodes in same order as m_NodeOrder, only edited nodes are saved
+    void SyncNodeOrder();
+    void FlushPendingState() const;                         // apply m_Pending, copies state once if it is still shared
+    void DropHistory(const char* action, const string& name);
+};
+
+// Saves snapshot of document on background thread, UI thread only takes reference of current state
+struct IMGUI_API DocumentAutoSave
+{
+    DocumentAutoSave() = default;
+    DocumentAutoSave(const DocumentAutoSave&) = delete;
+    DocumentAutoSave& operator=(const DocumentAutoSave&) = delete;
+    ~DocumentAutoSave();
+
+    void SetInterval(float seconds) { m_Interval = seconds; }  // 0 disables autosave in Update()
+    float GetInterval() const { return m_Interval; }
+    void SetPath(std::string path);                             // empty means document path with ".autosave" suffix
+
+    bool Update(Document& document);                            // call every frame, saves when interval passed and document is changed
+    bool Save(Document& document, std::string path = "");       // queue save now, newer request replaces pending one of same path
+    void Wait();                                                // block until all queued saves are written
+    void Stop();
+
+    bool IsSaving() const { return m_Busy; }
+    bool LastSaveSucceeded() const { return m_LastResult; }
+
+private:
+    void Worker();
+
+    struct Job
+    {
+        std::string                             m_Path;
+        shared_ptr<const Document::DocumentState> m_State;
+        imgui_json::value                       m_View;
+    };
+
+    float                       m_Interval {0.f};
+    std::string                 m_Path;
+    int64_t                     m_LastTime {0};
+    const Document*             m_SavedDocument {nullptr};
+    uint64_t                    m_SavedRevision {0};
+
+    std::thread                 m_Thread;
+    std::mutex                  m_Mutex;
+    std::condition_variable     m_Condition;
+    std::map<std::string, std::unique_ptr<Job>> m_Pending;     // one pending job per target path
+    std::atomic<bool>           m_Busy {false};
+    std::atomic<bool>           m_LastResult {true};
+    bool                        m_Quit {false};
 };
 
 } // namespace BluePrint
\ No newline at end of file
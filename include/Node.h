@@ -6,6 +6,9 @@
 #include <imgui_extra_widget.h>
 #include <imgui_curve.h>
 #include <inttypes.h>
+#include <unordered_map>
+#include <unordered_set>
+#include <atomic>
 #include <DynObjectLoader.h>
 
 #if IMGUI_ICONS
@@ -108,11 +111,42 @@ struct NodeTypeInfo
 	typedef void destroy_t(NodeTypeInfo*);
 };
 
+// HDR style histogram of node execution time in microseconds. Values fall into power of 2
+// ranges split in 8 linear sub buckets, so any reported value is within 12.5% of real one.
+// Execution thread records while UI thread reads, counters are relaxed atomics, so stats
+// taken during a run may miss the latest samples but never touch freed memory.
+// Buckets are allocated by first Record() and live as long as histogram, nodes never run cost a pointer.
+struct IMGUI_API LatencyHistogram
+{
+    static constexpr int SUB_BUCKET_BITS    = 3;
+    static constexpr int SUB_BUCKET_COUNT   = 1 << SUB_BUCKET_BITS;
+    static constexpr int BUCKET_COUNT       = (64 - SUB_BUCKET_BITS + 1) * SUB_BUCKET_COUNT;
+
+    LatencyHistogram() = default;
+    LatencyHistogram(const LatencyHistogram&) = delete;
+    LatencyHistogram& operator=(const LatencyHistogram&) = delete;
+    ~LatencyHistogram();
+
+    void            Record(uint64_t value);
+    void            Reset();
+    uint64_t        Percentile(double percent) const;
+    LatencyStats    GetStats() const;
+
+    std::atomic<std::atomic<uint32_t>*> m_Buckets {nullptr};   // BUCKET_COUNT counters
+    std::atomic<uint64_t>       m_Count {0};
+    std::atomic<uint64_t>       m_Max   {0};
+};
+
 struct IMGUI_API Node
 {
     Node(BP* blueprint);
     virtual ~Node() = default;
 
+    static void* operator new(size_t size);                     // heap
+    static void* operator new(size_t size, BP* blueprint);      // arena of blueprint, heap if it is null
+    static void  operator delete(void* ptr);
+    static void  operator delete(void* ptr, BP* blueprint);     // constructor threw
+
     template <typename T>
     unique_ptr<T> CreatePin(std::string name = "");
     unique_ptr<Pin> CreatePin(PinType pinType, std::string name = "");
@@ -232,6 +266,7 @@ struct IMGUI_API Node
     virtual bool            HasSetting() const;
     virtual bool            CustomLayout() const;
     virtual bool            Skippable() const;
+    virtual bool            ReportsEdits() const;   // true if every change of saved state calls MarkDirty() so BP::Save() may reuse m_SaveCache, false saves node every time
     virtual std::string     GetName() const;
     virtual void            SetName(std::string name);
     virtual void            SetBreakPoint(bool breaken);
@@ -250,7 +285,23 @@ struct IMGUI_API Node
     virtual void            OnNodeDelete(Node * node = nullptr) {};
 
     virtual int  Load(const imgui_json::value& value);
-    virtual void Save(imgui_json::value& value, std::map<ID_TYPE, ID_TYPE> MapID = {});
+    virtual void Save(imgui_json::value& value, const std::map<ID_TYPE, ID_TYPE>& MapID = {});
+    virtual Node* Clone(BP* blueprint, const std::map<ID_TYPE, ID_TYPE>& MapID = {}) { return nullptr; } // Copy node into blueprint without json, return nullptr to fall back to Save()/Load()
+    virtual bool CopyTo(Node& node, const std::map<ID_TYPE, ID_TYPE>& MapID = {}); // Copy base state and pins into node of same type, IDs are remapped like Save(MapID), override to copy own state
+    void MarkDirty();                           // Saved state changed, BP::Save() serializes this node again and blueprint lists it in TakeEditedNodes()
+    bool IsDirty() const { return m_Dirty; }
+
+    template <typename T>
+    Node* CloneAs(BP* blueprint, const std::map<ID_TYPE, ID_TYPE>& MapID)
+    {
+        auto node = new (blueprint) T(blueprint);
+        if (!CopyTo(*node, MapID))
+        {
+            delete node;
+            return nullptr;
+        }
+        return node;
+    }
 
     virtual void DrawSettingLayout(ImGuiContext * ctx);
     virtual void DrawMenuLayout(ImGuiContext * ctx);
@@ -271,10 +322,16 @@ struct IMGUI_API Node
     ID_TYPE         m_GroupID           {0};
     std::mutex      m_mutex;
 
+    // for incremental save
+    std::atomic<bool> m_Dirty     {true};  // set by any change of saved state, cleared by BP::Save()
+    imgui_json::value m_SaveCache;         // node record written by last BP::Save(), nodes which don't report edits keep none
+    std::atomic<uint64_t> m_EditEpoch {0}; // BP edit epoch node was last listed in, node is listed once per epoch
+
     // for Node banchmark
     uint64_t        m_Tick {0};
     uint64_t        m_Hits {0};
     double          m_NodeTimeMs    {0.f};
+    LatencyHistogram m_Latency;     // time of every Execute() since last BP::ResetLatency(), kept across runs
 };
 
 struct ClipNode
@@ -301,26 +358,53 @@ struct ClipNode
 
 struct IMGUI_API NodeRegistry
 {
+    // node plugin which is opened but not registered yet
+    // module without m_Object is registered lazily, it's opened by m_Path at first Create
+    struct NodeTypeModule
+    {
+        std::string                 m_Path;
+        DLClass<NodeTypeInfo>*      m_Object    {nullptr};
+        shared_ptr<NodeTypeInfo>    m_Info      {nullptr};
+    };
+
     NodeRegistry();
     ~NodeRegistry();
     ID_TYPE RegisterNodeType(shared_ptr<NodeTypeInfo> info);
     ID_TYPE RegisterNodeType(std::string Path);
+    static bool LoadNodeType(std::string Path, NodeTypeModule& module);     // thread safe, registry isn't touched
+    std::vector<ID_TYPE> RegisterNodeTypes(std::vector<NodeTypeModule>& modules); // take modules ownership, rebuild types once
     void UnregisterNodeType(std::string name);
     Node* Create(ID_TYPE typeId, BP* blueprint);
     Node* Create(std::string typeName, BP* blueprint);
     span<const NodeTypeInfo* const> GetTypes() const;
     span<const std::string> GetCatalogs() const;
-    span<const Node * const> GetNodes() const;
+    span<const Node * const> GetNodes() const;              // instantiate all missing prototype nodes
+    const Node* GetPrototype(ID_TYPE typeId) const;         // prototype node is created at first request
     const NodeTypeInfo* GetTypeInfo(ID_TYPE typeId) const;
 
 private:
     void RebuildTypes();
+    NodeTypeInfo& StoreCustomType(const NodeTypeInfo& info);
+    void InsertType(NodeTypeInfo* info);
+    void RemoveType(const NodeTypeInfo* info);
+    void RemoveTypeName(const NodeTypeInfo* info);
+    void InsertCatalog(const std::string& catalog);
+    void ReleasePrototype(ID_TYPE typeId);
+    NodeTypeInfo::Factory ResolveFactory(NodeTypeInfo* info) const;
+
     std::vector<NodeTypeInfo>   m_BuildInNodes;
-    std::vector<NodeTypeInfo>   m_CustomNodes;
-    std::vector<NodeTypeInfo*>  m_Types;
+    std::unordered_map<ID_TYPE, NodeTypeInfo>       m_CustomNodes;  // element address is stable while registered
+    std::vector<NodeTypeInfo*>  m_Types;                            // sorted by type ID
+    std::unordered_map<ID_TYPE, NodeTypeInfo*>      m_TypeIndex;
+    std::unordered_map<std::string, NodeTypeInfo*>  m_NameIndex;    // lowest type ID wins on same name
     std::vector<std::string>    m_Catalogs;
-    std::vector<DLClass<NodeTypeInfo>*> m_ExternalObject;
-    std::vector<Node *>         m_Nodes;
+    std::unordered_set<std::string>                 m_CatalogIndex;
+    mutable std::vector<DLClass<NodeTypeInfo>*> m_ExternalObject;
+    mutable std::unordered_map<ID_TYPE, std::string>  m_LazyModules;  // type ID -> plugin path, not opened yet
+    mutable std::mutex          m_LazyMutex;
+    mutable std::unordered_map<ID_TYPE, Node *>     m_Prototypes;
+    mutable std::vector<Node *> m_Nodes;
+    mutable std::mutex          m_PrototypeMutex;
 };
 
 } // namespace BluePrint
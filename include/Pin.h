@@ -1,5 +1,7 @@
 #pragma once
 #include <iostream>
+#include <unordered_map>
+#include <shared_mutex>
 #include <BluePrint.h>
 #include <immat.h>
 
@@ -134,6 +136,11 @@ struct IMGUI_API Pin
     Pin(Node* node, PinType type, std::string name = "");
     virtual ~Pin();
 
+    static void* operator new(size_t size);                     // heap
+    static void* operator new(size_t size, BP* blueprint);      // arena of blueprint, heap if it is null
+    static void  operator delete(void* ptr);
+    static void  operator delete(void* ptr, BP* blueprint);     // constructor threw
+
     virtual bool     SetValueType(PinType type) { return m_Type == type; }  // By default, type of held value cannot be changed
     virtual PinType  GetValueType() const;                                  // Returns type of held value (may be different from GetType() for Any pin)
     virtual bool     SetValue(const PinValue& value) { return false; }      // Sets new value to be held by the pin (not all allow data to be modified)
@@ -155,9 +162,11 @@ struct IMGUI_API Pin
 
     bool IsMappedPin() const;                           // Pin is Bridge/Shadow pin
     bool IsLinkedExportedPin() const;                   // Pin is linked with group export pin
+    void MarkDirty();                                   // Owning node is saved again on next BP::Save()
 
     virtual bool Load(const imgui_json::value& value);
-    virtual void Save(imgui_json::value& value, std::map<ID_TYPE, ID_TYPE> MapID = {}) const;
+    virtual void Save(imgui_json::value& value, const std::map<ID_TYPE, ID_TYPE>& MapID = {}) const;
+    virtual bool CopyFrom(const Pin& pin, const std::map<ID_TYPE, ID_TYPE>& MapID = {}); // Same result as pin.Save(MapID) followed by Load(), without json
 
     ID_TYPE         m_ID        {static_cast<ID_TYPE>(-1)};
     Node*           m_Node      {nullptr};
@@ -325,7 +334,8 @@ struct IMGUI_API AnyPin final : Pin
     PinValue GetValue() const override { return m_InnerPin ? m_InnerPin->GetValue() : PinValue{}; }
 
     bool Load(const imgui_json::value& value) override;
-    void Save(imgui_json::value& value, std::map<ID_TYPE, ID_TYPE> MapID = {}) const override;
+    void Save(imgui_json::value& value, const std::map<ID_TYPE, ID_TYPE>& MapID = {}) const override;
+    bool CopyFrom(const Pin& pin, const std::map<ID_TYPE, ID_TYPE>& MapID = {}) override;
 
     std::unique_ptr<Pin> m_InnerPin;
 };
@@ -358,13 +368,15 @@ struct IMGUI_API BoolPin final : Pin
         if (value.GetType() != TypeId)
             return false;
         m_Value = value.As<bool>();
+        MarkDirty();
         return true;
     }
 
     PinValue GetValue() const override { return m_Value; }
 
     bool Load(const imgui_json::value& value) override;
-    void Save(imgui_json::value& value, std::map<ID_TYPE, ID_TYPE> MapID = {}) const override;
+    void Save(imgui_json::value& value, const std::map<ID_TYPE, ID_TYPE>& MapID = {}) const override;
+    bool CopyFrom(const Pin& pin, const std::map<ID_TYPE, ID_TYPE>& MapID = {}) override;
 
     bool m_Value = false;
 };
@@ -382,13 +394,15 @@ struct IMGUI_API Int32Pin final : Pin
         if (value.GetType() != TypeId)
             return false;
         m_Value = value.As<int32_t>();
+        MarkDirty();
         return true;
     }
 
     PinValue GetValue() const override { return m_Value; }
 
     bool Load(const imgui_json::value& value) override;
-    void Save(imgui_json::value& value, std::map<ID_TYPE, ID_TYPE> MapID = {}) const override;
+    void Save(imgui_json::value& value, const std::map<ID_TYPE, ID_TYPE>& MapID = {}) const override;
+    bool CopyFrom(const Pin& pin, const std::map<ID_TYPE, ID_TYPE>& MapID = {}) override;
 
     int32_t m_Value = 0;
 };
@@ -406,13 +420,15 @@ struct IMGUI_API Int64Pin final : Pin
         if (value.GetType() != TypeId)
             return false;
         m_Value = value.As<int64_t>();
+        MarkDirty();
         return true;
     }
 
     PinValue GetValue() const override { return m_Value; }
 
     bool Load(const imgui_json::value& value) override;
-    void Save(imgui_json::value& value, std::map<ID_TYPE, ID_TYPE> MapID = {}) const override;
+    void Save(imgui_json::value& value, const std::map<ID_TYPE, ID_TYPE>& MapID = {}) const override;
+    bool CopyFrom(const Pin& pin, const std::map<ID_TYPE, ID_TYPE>& MapID = {}) override;
 
     int64_t m_Value = 0;
 };
@@ -429,13 +445,15 @@ struct IMGUI_API FloatPin final : Pin
         if (value.GetType() != TypeId)
             return false;
         m_Value = value.As<float>();
+        MarkDirty();
         return true;
     }
 
     PinValue GetValue() const override { return m_Value; }
 
     bool Load(const imgui_json::value& value) override;
-    void Save(imgui_json::value& value, std::map<ID_TYPE, ID_TYPE> MapID = {}) const override;
+    void Save(imgui_json::value& value, const std::map<ID_TYPE, ID_TYPE>& MapID = {}) const override;
+    bool CopyFrom(const Pin& pin, const std::map<ID_TYPE, ID_TYPE>& MapID = {}) override;
 
     float m_Value = 0.0f;
 };
@@ -452,13 +470,15 @@ struct IMGUI_API DoublePin final : Pin
         if (value.GetType() != TypeId)
             return false;
         m_Value = value.As<double>();
+        MarkDirty();
         return true;
     }
 
     PinValue GetValue() const override { return m_Value; }
 
     bool Load(const imgui_json::value& value) override;
-    void Save(imgui_json::value& value, std::map<ID_TYPE, ID_TYPE> MapID = {}) const override;
+    void Save(imgui_json::value& value, const std::map<ID_TYPE, ID_TYPE>& MapID = {}) const override;
+    bool CopyFrom(const Pin& pin, const std::map<ID_TYPE, ID_TYPE>& MapID = {}) override;
 
     double m_Value = 0.0f;
 };
@@ -476,13 +496,15 @@ struct IMGUI_API StringPin final : Pin
         if (value.GetType() != TypeId)
             return false;
         m_Value = value.As<std::string>();
+        MarkDirty();
         return true;
     }
 
     PinValue GetValue() const override { return m_Value; }
 
     bool Load(const imgui_json::value& value) override;
-    void Save(imgui_json::value& value, std::map<ID_TYPE, ID_TYPE> MapID = {}) const override;
+    void Save(imgui_json::value& value, const std::map<ID_TYPE, ID_TYPE>& MapID = {}) const override;
+    bool CopyFrom(const Pin& pin, const std::map<ID_TYPE, ID_TYPE>& MapID = {}) override;
 
     std::string m_Value;
 };
@@ -506,7 +528,7 @@ struct IMGUI_API PointPin final : Pin
     PinValue GetValue() const override { return m_Value; }
 
     bool Load(const imgui_json::value& value) override;
-    void Save(imgui_json::value& value, std::map<ID_TYPE, ID_TYPE> MapID = {}) const override;
+    void Save(imgui_json::value& value, const std::map<ID_TYPE, ID_TYPE>& MapID = {}) const override;
 
     uintptr_t m_Value;
 };
@@ -523,13 +545,15 @@ struct IMGUI_API Vec2Pin final : Pin
         if (value.GetType() != TypeId)
             return false;
         m_Value = value.As<ImVec2>();
+        MarkDirty();
         return true;
     }
 
     PinValue GetValue() const override { return m_Value; }
 
     bool Load(const imgui_json::value& value) override;
-    void Save(imgui_json::value& value, std::map<ID_TYPE, ID_TYPE> MapID = {}) const override;
+    void Save(imgui_json::value& value, const std::map<ID_TYPE, ID_TYPE>& MapID = {}) const override;
+    bool CopyFrom(const Pin& pin, const std::map<ID_TYPE, ID_TYPE>& MapID = {}) override;
 
     ImVec2 m_Value {0.f, 0.f};
 };
@@ -546,13 +570,15 @@ struct IMGUI_API Vec4Pin final : Pin
         if (value.GetType() != TypeId)
             return false;
         m_Value = value.As<ImVec4>();
+        MarkDirty();
         return true;
     }
 
     PinValue GetValue() const override { return m_Value; }
 
     bool Load(const imgui_json::value& value) override;
-    void Save(imgui_json::value& value, std::map<ID_TYPE, ID_TYPE> MapID = {}) const override;
+    void Save(imgui_json::value& value, const std::map<ID_TYPE, ID_TYPE>& MapID = {}) const override;
+    bool CopyFrom(const Pin& pin, const std::map<ID_TYPE, ID_TYPE>& MapID = {}) override;
 
     ImVec4 m_Value {0.f, 0.f, 0.f, 0.f};
 };
@@ -575,7 +601,7 @@ struct IMGUI_API ArrayPin final : Pin
     PinValue GetValue() const override { return m_Value; }
 
     bool Load(const imgui_json::value& value) override;
-    void Save(imgui_json::value& value, std::map<ID_TYPE, ID_TYPE> MapID = {}) const override;
+    void Save(imgui_json::value& value, const std::map<ID_TYPE, ID_TYPE>& MapID = {}) const override;
 
     imgui_json::array m_Value;
 };
@@ -598,7 +624,7 @@ struct IMGUI_API MatPin final : Pin
     PinValue GetValue() const override { return m_Value; }
 
     bool Load(const imgui_json::value& value) override;
-    void Save(imgui_json::value& value, std::map<ID_TYPE, ID_TYPE> MapID = {}) const override;
+    void Save(imgui_json::value& value, const std::map<ID_TYPE, ID_TYPE>& MapID = {}) const override;
 
     ImGui::ImMat m_Value = {};
 };
@@ -648,7 +674,8 @@ struct IMGUI_API CustomPin final : Pin
     }
 
     bool Load(const imgui_json::value& value) override;
-    void Save(imgui_json::value& value, std::map<ID_TYPE, ID_TYPE> MapID = {}) const override;
+    void Save(imgui_json::value& value, const std::map<ID_TYPE, ID_TYPE>& MapID = {}) const override;
+    bool CopyFrom(const Pin& pin, const std::map<ID_TYPE, ID_TYPE>& MapID = {}) override;
 
     LinkQueryResult CanLinkTo(const Pin& pin) const override;
     PinEx& GetPinEx() const { return *m_pPinEx; }
@@ -662,15 +689,32 @@ private:
 class PinExRegistry
 {
 public:
+    // pin plugin which is opened but not registered yet
+    struct PinExModule
+    {
+        std::string             m_Path;
+        void*                   m_Handle    {nullptr};
+        const PinExModuleInfo*  m_Info      {nullptr};
+    };
+
     PinExRegistry() {}
     ~PinExRegistry();
 
     const PinTypeEx* RegisterPinEx(std::string module_path);
-    PinEx* Create(std::string typeName);
+    const PinTypeEx* RegisterPinEx(const PinExModuleInfo* info);                    // pin type built in application, no module
+    static bool LoadPinEx(std::string module_path, PinExModule& module);            // thread safe, registry isn't touched
+    std::vector<const PinTypeEx*> RegisterPinExs(std::vector<PinExModule>& modules); // take modules ownership
+    PinEx* Create(const std::string& typeName);
+    const PinExModuleInfo* GetTypeInfo(const std::string& typeName) const;
 
 private:
+    const PinTypeEx* InsertPinEx(const PinExModuleInfo* info, const std::string& module_path);
+    const PinExModuleInfo* FindTypeInfo(const std::string& typeName) const;
+
     std::vector<const PinExModuleInfo*>  m_TypeInfos;
-    void* m_dll_handle {nullptr};
+    std::unordered_multimap<uint32_t, const PinExModuleInfo*> m_TypeIndex;  // fnv1a hash of type name
+    std::vector<void*>  m_DllHandles;                                       // every loaded module, closed at exit
+    mutable std::shared_mutex m_Mutex;
 };
 } // namespace BluePrint
 
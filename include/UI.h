@@ -223,18 +223,19 @@ typedef struct BluePrintCallbackFunctions
 
 struct BluePrintUI
 {
-    static void LoadPlugins(const std::vector<std::string>& pluginPaths, int& current_index, std::string& current_message, float& loading_percentage, int expect_count);
+    static void LoadPlugins(const std::vector<std::string>& pluginPaths, int& current_index, std::string& current_message, float& loading_percentage, int expect_count, std::string manifest_path = ""); // empty manifest path means per application file in user cache folder
     static int CheckPlugins(const std::vector<std::string>& pluginPaths);
     BluePrintUI();
     void Initialize(const char * bp_file = nullptr);
     void Finalize();
-    bool Frame(bool child_window = false, bool show_node = true, bool bp_enabled = true, uint32_t flag = BluePrintFlag::BluePrintFlag_All);
+    bool Frame(bool child_window = false, bool show_node = true, bool bp_enabled = true, uint32_t flag = BluePrintFlag::BluePrintFlag_All, bool* need_update = nullptr); // need_update false means host may sleep until next input event
     void SetStyle(enum BluePrintStyle style = BluePrintStyle::BP_Style_BluePrint);
     void SetCallbacks(BluePrintCallbackFunctions callbacks, void * handle);
     
     ed::Config                      m_Config;
     ed::EditorContext*              m_Editor {nullptr};
     unique_ptr<Document>            m_Document {nullptr};
+    DocumentAutoSave                m_AutoSave;                 // disabled until interval is set
     imgui_json::value               m_OpRecord;
     ImGuiFileDialog                 m_FileDialog;
     std::string                     m_BookMarkPath;
@@ -244,6 +245,8 @@ struct BluePrintUI
     bool                            m_isShowInfoTooltips {false};
     bool                            m_isShowThumbnails {false};
     float                           m_ThumbnailScale {0.25f};
+    bool                            m_isCullNodes {true};       // nodes out of view are committed as bare frames
+    float                           m_LodZoom {2.5f};           // above this zoom nodes are drawn as plain rectangles, 0 disables
     int                             m_ThumbnailShowCount {0};
     Pin*                            m_newNodeLinkPin {nullptr};
     ImVec4                          m_StyleColors[BluePrintStyleColor_Count];
@@ -371,6 +374,7 @@ private:
     bool                CheckNodeStyle(const Node* node, NodeStyle style);
     float               DrawNodeToolBar(Node *node, Node **need_clone_node);
     void                DrawNodes();
+    void                DrawNodeStub(Node* node, const ImVec2& node_size);
     void                DrawInfoTooltip();
     void                ShowDialogs();
     void                FileDialogs();
@@ -387,7 +391,14 @@ private:
     void                CreateNewFilterDocument();
     void                CreateNewTransitionDocument();
     void                CommitLinksToEditor();
+    void                ShowFlow();
+    bool                CheckNeedUpdate();
     bool                ReadyToQuit {false};
+    double              m_FlowUntil {0};                    // ImGui time when flow markers stop moving
+    double              m_UpdateUntil {0};                  // ImGui time when UI is settled after last input or change
+    uint64_t            m_UpdateLinkRevision {0};
+    uint64_t            m_UpdateStateRevision {0};
+    std::unordered_map<ID_TYPE, ImRect> m_CulledNodes;          // bounds of nodes culled in this frame, consumed by CommitLinksToEditor
 
 public:
     BluePrintCallbackFunctions  m_CallBacks;
@@ -32,7 +32,8 @@ const vector<Node*> GetGroupedNodes(Node& node); // Returns grouped nodes as a v
 const vector<Pin*> GetSelectedLinks(BP* blueprint); // Returns selected links as a vector.
 const char * StepResultToString(StepResult stepResult);
 std::string IDToHexString(const ID_TYPE i);
-ID_TYPE GetIDFromMap(ID_TYPE ID, std::map<ID_TYPE, ID_TYPE> MapID);
+ID_TYPE GetIDFromMap(ID_TYPE ID, const std::map<ID_TYPE, ID_TYPE>& MapID);
+bool GetFileStamp(const std::string& path, std::string& mtime, int64_t& size); // Last write time and size of file, false if it can't be read. mtime is a string, file clock ticks don't fit json number.
 // Uses ImDrawListSplitter to draw background under pin value
 struct PinValueBackgroundRenderer
 {
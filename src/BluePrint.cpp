@@ -1,8 +1,18 @@
 #include <BluePrint.h>
 #include <Node.h>
+#include <Utils.h>
 #include <imgui_helper.h>
 #include <BuildInNodes.h> // Which is generated by cmake
 #include <imgui_node_editor.h>
+#include <cmath>
+#include <cinttypes>
+#include <filesystem>
+#if !defined(_WIN32) && !defined(__EMSCRIPTEN__)
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
 
 namespace ed = ax::NodeEditor;
 
@@ -34,6 +44,638 @@ ID_TYPE IDGenerator::State() const
     return m_State;
 }
 
+// -----------------------------
+// --------[ JsonWriter ]-------
+// -----------------------------
+# pragma region JsonWriter
+#define JSON_WRITER_CHUNK_SIZE  (64 * 1024)
+
+JsonWriter::JsonWriter(FILE* file, int indent)
+    : m_File(file), m_Indent(indent)
+{
+    m_Good = file != nullptr;
+    m_Chunk.reserve(JSON_WRITER_CHUNK_SIZE * 2);
+}
+
+JsonWriter::JsonWriter(std::string& buffer, int indent)
+    : m_Buffer(&buffer), m_Indent(indent)
+{
+}
+
+void JsonWriter::NewLine()
+{
+    if (m_Indent < 0)
+        return;
+    m_Chunk.push_back('\n');
+    m_Chunk.append(m_HasItem.size() * m_Indent, ' ');
+}
+
+void JsonWriter::BeginValue()
+{
+    if (m_AfterKey)
+    {
+        m_AfterKey = false;
+        return;
+    }
+    if (!m_HasItem.empty())
+    {
+        if (m_HasItem.back()) m_Chunk.push_back(',');
+        m_HasItem.back() = true;
+        NewLine();
+    }
+}
+
+void JsonWriter::BeginObject()
+{
+    BeginValue();
+    m_Chunk.push_back('{');
+    m_HasItem.push_back(false);
+}
+
+void JsonWriter::EndObject()
+{
+    bool hasItem = m_HasItem.back();
+    m_HasItem.pop_back();
+    if (hasItem) NewLine();
+    m_Chunk.push_back('}');
+    if (m_Chunk.size() >= JSON_WRITER_CHUNK_SIZE) Flush();
+}
+
+void JsonWriter::BeginArray()
+{
+    BeginValue();
+    m_Chunk.push_back('[');
+    m_HasItem.push_back(false);
+}
+
+void JsonWriter::EndArray()
+{
+    bool hasItem = m_HasItem.back();
+    m_HasItem.pop_back();
+    if (hasItem) NewLine();
+    m_Chunk.push_back(']');
+    if (m_Chunk.size() >= JSON_WRITER_CHUNK_SIZE) Flush();
+}
+
+void JsonWriter::Key(const std::string& key)
+{
+    BeginValue();
+    WriteEscaped(key);
+    m_Chunk.append(m_Indent < 0 ? ":" : ": ");
+    m_AfterKey = true;
+}
+
+void JsonWriter::String(const std::string& str)
+{
+    BeginValue();
+    WriteEscaped(str);
+}
+
+void JsonWriter::Number(double number)
+{
+    BeginValue();
+    char buffer[32];
+    if (!std::isfinite(number))
+        snprintf(buffer, sizeof(buffer), "null");
+    else if (number == (double)(int64_t)number && std::fabs(number) < 9007199254740992.0)
+        snprintf(buffer, sizeof(buffer), "%" PRId64, (int64_t)number);
+    else
+        snprintf(buffer, sizeof(buffer), "%.17g", number);
+    m_Chunk.append(buffer);
+}
+
+void JsonWriter::Boolean(bool boolean)
+{
+    BeginValue();
+    m_Chunk.append(boolean ? "true" : "false");
+}
+
+void JsonWriter::Null()
+{
+    BeginValue();
+    m_Chunk.append("null");
+}
+
+void JsonWriter::Value(const imgui_json::value& value)
+{
+    if (value.is_boolean())
+        Boolean(value.get<imgui_json::boolean>());
+    else if (value.is_number())
+        Number(value.get<imgui_json::number>());
+    else if (value.is_string())
+        String(value.get<imgui_json::string>());
+    else if (value.is_array())
+    {
+        BeginArray();
+        for (auto& item : value.get<imgui_json::array>())
+            Value(item);
+        EndArray();
+    }
+    else if (value.is_object())
+    {
+        BeginObject();
+        for (auto& item : value.get<imgui_json::object>())
+        {
+            Key(item.first);
+            Value(item.second);
+        }
+        EndObject();
+    }
+    else
+        Null();
+}
+
+void JsonWriter::WriteEscaped(const std::string& str)
+{
+    m_Chunk.push_back('"');
+    for (unsigned char c : str)
+    {
+        switch (c)
+        {
+            case '"':   m_Chunk.append("\\\""); break;
+            case '\\':  m_Chunk.append("\\\\"); break;
+            case '\b':  m_Chunk.append("\\b"); break;
+            case '\f':  m_Chunk.append("\\f"); break;
+            case '\n':  m_Chunk.append("\\n"); break;
+            case '\r':  m_Chunk.append("\\r"); break;
+            case '\t':  m_Chunk.append("\\t"); break;
+            default:
+                if (c < 0x20)
+                {
+                    char buffer[8];
+                    snprintf(buffer, sizeof(buffer), "\\u%04x", c);
+                    m_Chunk.append(buffer);
+                }
+                else
+                    m_Chunk.push_back((char)c);
+                break;
+        }
+    }
+    m_Chunk.push_back('"');
+}
+
+bool JsonWriter::Flush()
+{
+    if (m_Chunk.empty())
+        return m_Good;
+    if (m_Buffer)
+        m_Buffer->append(m_Chunk);
+    else if (!m_File || fwrite(m_Chunk.data(), 1, m_Chunk.size(), m_File) != m_Chunk.size())
+        m_Good = false;
+    m_Chunk.clear();
+    return m_Good;
+}
+# pragma endregion
+
+// -----------------------------
+// ----------[ Binary ]---------
+// -----------------------------
+# pragma region Binary
+enum BinaryValueTag : uint8_t
+{
+    BinaryValueTag_Null = 0,
+    BinaryValueTag_False,
+    BinaryValueTag_True,
+    BinaryValueTag_Int32,
+    BinaryValueTag_UInt32,
+    BinaryValueTag_Number,
+    BinaryValueTag_String,
+    BinaryValueTag_Array,
+    BinaryValueTag_Object,
+};
+
+#define BINARY_VALUE_MAX_DEPTH  256
+#define GROUP_TEMPLATE_CACHE_SIZE   16
+
+void BinaryWriter::Write(const void* data, size_t size)
+{
+    auto offset = m_Buffer.size();
+    m_Buffer.resize(offset + size);
+    if (size) memcpy(m_Buffer.data() + offset, data, size);
+}
+
+void BinaryWriter::WriteString(const std::string& str)
+{
+    Write<uint32_t>((uint32_t)str.size());
+    Write(str.data(), str.size());
+}
+
+void BinaryWriter::WriteValue(const imgui_json::value& value)
+{
+    if (value.is_boolean())
+    {
+        Write<uint8_t>(value.get<imgui_json::boolean>() ? BinaryValueTag_True : BinaryValueTag_False);
+    }
+    else if (value.is_number())
+    {
+        // most numbers are IDs, flags and counters, store them as 32bit integer
+        auto number = value.get<imgui_json::number>();
+        if (number >= (double)INT32_MIN && number <= (double)INT32_MAX && number == (double)(int32_t)number && !(number == 0 && std::signbit(number)))
+        {
+            Write<uint8_t>(BinaryValueTag_Int32);
+            Write<int32_t>((int32_t)number);
+        }
+        else if (number >= 0 && number <= (double)UINT32_MAX && number == (double)(uint32_t)number)
+        {
+            Write<uint8_t>(BinaryValueTag_UInt32);
+            Write<uint32_t>((uint32_t)number);
+        }
+        else
+        {
+            Write<uint8_t>(BinaryValueTag_Number);
+            Write<double>(number);
+        }
+    }
+    else if (value.is_string())
+    {
+        Write<uint8_t>(BinaryValueTag_String);
+        WriteString(value.get<imgui_json::string>());
+    }
+    else if (value.is_array())
+    {
+        auto& array = value.get<imgui_json::array>();
+        Write<uint8_t>(BinaryValueTag_Array);
+        Write<uint32_t>((uint32_t)array.size());
+        for (auto& item : array)
+            WriteValue(item);
+    }
+    else if (value.is_object())
+    {
+        auto& object = value.get<imgui_json::object>();
+        Write<uint8_t>(BinaryValueTag_Object);
+        Write<uint32_t>((uint32_t)object.size());
+        for (auto& item : object)
+        {
+            WriteString(item.first);
+            WriteValue(item.second);
+        }
+    }
+    else
+    {
+        Write<uint8_t>(BinaryValueTag_Null);
+    }
+}
+
+bool BinaryWriter::Save(std::string path) const
+{
+    auto file = fopen(path.c_str(), "wb");
+    if (!file)
+        return false;
+    bool ret = fwrite(m_Buffer.data(), 1, m_Buffer.size(), file) == m_Buffer.size();
+    ret = (fclose(file) == 0) && ret;
+    return ret;
+}
+
+bool BinaryReader::Read(void* data, size_t size)
+{
+    if (Remain() < size)
+        return false;
+    if (size) memcpy(data, m_Ptr, size);
+    m_Ptr += size;
+    return true;
+}
+
+bool BinaryReader::ReadString(std::string& str)
+{
+    uint32_t size = 0;
+    if (!Read(size) || Remain() < size)
+        return false;
+    str.assign((const char*)m_Ptr, size);
+    m_Ptr += size;
+    return true;
+}
+
+bool BinaryReader::ReadValue(imgui_json::value& value)
+{
+    return ReadValue(value, 0);
+}
+
+bool BinaryReader::ReadValue(imgui_json::value& value, int depth)
+{
+    uint8_t tag = 0;
+    if (depth > BINARY_VALUE_MAX_DEPTH || !Read(tag))
+        return false;
+    switch (tag)
+    {
+        case BinaryValueTag_Null:   value = imgui_json::value(); return true;
+        case BinaryValueTag_False:  value = imgui_json::boolean(false); return true;
+        case BinaryValueTag_True:   value = imgui_json::boolean(true); return true;
+        case BinaryValueTag_Int32:
+        {
+            int32_t number = 0;
+            if (!Read(number)) return false;
+            value = imgui_json::number(number);
+            return true;
+        }
+        case BinaryValueTag_UInt32:
+        {
+            uint32_t number = 0;
+            if (!Read(number)) return false;
+            value = imgui_json::number(number);
+            return true;
+        }
+        case BinaryValueTag_Number:
+        {
+            double number = 0;
+            if (!Read(number)) return false;
+            value = imgui_json::number(number);
+            return true;
+        }
+        case BinaryValueTag_String:
+        {
+            std::string str;
+            if (!ReadString(str)) return false;
+            value = imgui_json::string(std::move(str));
+            return true;
+        }
+        case BinaryValueTag_Array:
+        {
+            uint32_t count = 0;
+            if (!Read(count) || count > Remain()) // every item takes one byte at least
+                return false;
+            value = imgui_json::array();
+            for (uint32_t i = 0; i < count; i++)
+            {
+                imgui_json::value item;
+                if (!ReadValue(item, depth + 1))
+                    return false;
+                value.push_back(std::move(item));
+            }
+            return true;
+        }
+        case BinaryValueTag_Object:
+        {
+            uint32_t count = 0;
+            if (!Read(count) || count > Remain())
+                return false;
+            value = imgui_json::object();
+            for (uint32_t i = 0; i < count; i++)
+            {
+                std::string key;
+                if (!ReadString(key) || !ReadValue(value[key], depth + 1))
+                    return false;
+            }
+            return true;
+        }
+        default: return false;
+    }
+}
+
+bool BinaryReader::Skip(size_t size)
+{
+    if (Remain() < size)
+        return false;
+    m_Ptr += size;
+    return true;
+}
+
+BinaryReader BinaryReader::SubReader(size_t size) const
+{
+    return BinaryReader(m_Ptr, std::min(size, Remain()));
+}
+
+bool MappedFile::Open(std::string path)
+{
+    Close();
+#if !defined(_WIN32) && !defined(__EMSCRIPTEN__)
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+        return false;
+    struct stat st;
+    if (fstat(fd, &st) != 0)
+    {
+        close(fd);
+        return false;
+    }
+    m_Size = (size_t)st.st_size;
+    if (m_Size == 0)
+    {
+        close(fd);
+        return true;
+    }
+    void* data = mmap(nullptr, m_Size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED)
+    {
+        m_Size = 0;
+        return false;
+    }
+    madvise(data, m_Size, MADV_SEQUENTIAL);
+    m_Data = (const uint8_t*)data;
+    m_Mapped = true;
+    return true;
+#else
+    auto file = fopen(path.c_str(), "rb");
+    if (!file)
+        return false;
+    fseek(file, 0, SEEK_END);
+    auto size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    if (size < 0)
+    {
+        fclose(file);
+        return false;
+    }
+    m_Buffer.resize((size_t)size);
+    bool ret = fread(m_Buffer.data(), 1, m_Buffer.size(), file) == m_Buffer.size();
+    fclose(file);
+    if (!ret)
+    {
+        m_Buffer.clear();
+        return false;
+    }
+    m_Data = m_Buffer.data();
+    m_Size = m_Buffer.size();
+    return true;
+#endif
+}
+
+void MappedFile::Close()
+{
+#if !defined(_WIN32) && !defined(__EMSCRIPTEN__)
+    if (m_Mapped && m_Data)
+        munmap((void*)m_Data, m_Size);
+#endif
+    m_Buffer.clear();
+    m_Data = nullptr;
+    m_Size = 0;
+    m_Mapped = false;
+}
+# pragma endregion
+
+// -----------------------------
+// -------[ GroupTemplate ]-----
+// -----------------------------
+# pragma region GroupTemplate
+// Exported group files by path. Entry is shared, an import in progress keeps its
+// template alive while the file is parsed again after it changed. Cache keeps last
+// GROUP_TEMPLATE_CACHE_SIZE files, least recently imported one is dropped first.
+struct GroupTemplateFile
+{
+    std::string         m_MTime;
+    int64_t             m_Size  {0};
+    uint64_t            m_LastUse {0};
+    imgui_json::value   m_Value;
+    GroupTemplate       m_Template; // points into m_Value
+};
+
+static std::unordered_map<std::string, std::shared_ptr<GroupTemplateFile>> s_GroupTemplates;
+static std::mutex s_GroupTemplateMutex;
+static uint64_t s_GroupTemplateUse = 0;
+
+static std::shared_ptr<GroupTemplateFile> GetGroupTemplate(const std::string& path)
+{
+    std::string mtime;
+    int64_t size = 0;
+    if (!GetFileStamp(path, mtime, size))
+        return nullptr;
+
+    {
+        std::lock_guard<std::mutex> lock(s_GroupTemplateMutex);
+        auto it = s_GroupTemplates.find(path);
+        if (it != s_GroupTemplates.end() && it->second->m_MTime == mtime && it->second->m_Size == size)
+        {
+            it->second->m_LastUse = ++s_GroupTemplateUse;
+            return it->second;
+        }
+    }
+
+    auto loadResult = imgui_json::value::load(path);
+    if (!loadResult.second)
+        return nullptr;
+
+    auto file = std::make_shared<GroupTemplateFile>();
+    file->m_MTime = mtime;
+    file->m_Size = size;
+    file->m_Value = std::move(loadResult.first);
+    if (!file->m_Template.Build(file->m_Value))
+        return nullptr;
+
+    std::lock_guard<std::mutex> lock(s_GroupTemplateMutex);
+    file->m_LastUse = ++s_GroupTemplateUse;
+    s_GroupTemplates[path] = file;
+    while (s_GroupTemplates.size() > GROUP_TEMPLATE_CACHE_SIZE)
+    {
+        auto oldest = std::min_element(s_GroupTemplates.begin(), s_GroupTemplates.end(), [](const auto& a, const auto& b)
+        {
+            return a.second->m_LastUse < b.second->m_LastUse;
+        });
+        s_GroupTemplates.erase(oldest);
+    }
+    return file;
+}
+# pragma endregion
+
+// -----------------------------
+// ---------[ BPArena ]---------
+// -----------------------------
+# pragma region BPArena
+std::atomic<bool> BPArena::s_Enabled {true};
+
+void* BPArena::Allocate(BPArena* arena, size_t size)
+{
+    auto slot_size = (HEADER_SIZE + size + alignof(std::max_align_t) - 1) & ~(alignof(std::max_align_t) - 1);
+    void* slot = nullptr;
+    if (arena && slot_size <= MAX_OBJECT_SIZE && s_Enabled.load(std::memory_order_relaxed))
+        slot = arena->Take(slot_size);
+    else
+    {
+        arena = nullptr;
+        slot = ::operator new(slot_size);
+    }
+    auto header = static_cast<Header*>(slot);
+    header->m_Arena = arena;
+    header->m_Size = slot_size;
+    return static_cast<char*>(slot) + HEADER_SIZE;
+}
+
+void BPArena::Free(void* ptr)
+{
+    if (!ptr)
+        return;
+    auto slot = static_cast<char*>(ptr) - HEADER_SIZE;
+    auto header = reinterpret_cast<Header*>(slot);
+    auto arena = header->m_Arena;
+    if (!arena)
+        ::operator delete(slot);
+    else if (arena->Put(slot, header->m_Size))
+        delete arena;
+}
+
+void BPArena::SetEnabled(bool enable)
+{
+    s_Enabled.store(enable, std::memory_order_relaxed);
+}
+
+void* BPArena::Take(size_t size)
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_Live++;
+    auto it = m_FreeLists.find(size);
+    if (it != m_FreeLists.end() && it->second)
+    {
+        auto slot = it->second;
+        it->second = *reinterpret_cast<void**>(static_cast<char*>(slot) + HEADER_SIZE);
+        return slot;
+    }
+    if (m_Left < size)
+    {
+        // rest of current block is left unused, objects are small against block size
+        m_Blocks.emplace_back(new char[BLOCK_SIZE]);
+        m_Cursor = m_Blocks.back().get();
+        m_Left = BLOCK_SIZE;
+    }
+    auto slot = m_Cursor;
+    m_Cursor += size;
+    m_Left -= size;
+    return slot;
+}
+
+bool BPArena::Put(void* slot, size_t size)
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    auto& head = m_FreeLists[size];
+    *reinterpret_cast<void**>(static_cast<char*>(slot) + HEADER_SIZE) = head;
+    head = slot;
+    m_Live--;
+    return m_Detached && m_Live == 0;
+}
+
+void BPArena::Trim()
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    if (m_Live)
+        return;
+    m_FreeLists.clear();
+    m_Blocks.clear();
+    m_Cursor = nullptr;
+    m_Left = 0;
+}
+
+void BPArena::Detach()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_Detached = true;
+        if (m_Live)
+            return;
+    }
+    delete this;
+}
+
+size_t BPArena::GetLiveCount() const
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    return m_Live;
+}
+
+size_t BPArena::GetBlockCount() const
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    return m_Blocks.size();
+}
+# pragma endregion
+
 // ---------------------------
 // ----------[ BP ]-----------
 // ---------------------------
@@ -44,24 +686,31 @@ BP::BP()
 BP::BP(const BP& other)
     : m_Context(other.m_Context)
 {
-    imgui_json::value value;
-    other.Save(value);
-    Load(value);
+    CloneFrom(other);
 }
 
 BP::BP(BP&& other)
     : m_Generator(std::move(other.m_Generator))
     , m_Nodes(std::move(other.m_Nodes))
     , m_Pins(std::move(other.m_Pins))
+    , m_Arena(other.m_Arena)
     , m_Context(std::move(other.m_Context))
 {
+    other.m_Arena = nullptr;
     for (auto& node : m_Nodes)
+    {
         node->m_Blueprint = this;
+        node->m_EditEpoch = 0;
+    }
+    other.InvalidateIndex();
+    other.TouchLinks();
 }
 
 BP::~BP()
 {
     Clear();
+    if (m_Arena)
+        m_Arena->Detach();
 }
 
 BP& BP::operator=(const BP& other)
@@ -73,9 +722,7 @@ BP& BP::operator=(const BP& other)
 
     m_Context = other.m_Context;
 
-    imgui_json::value value;
-    other.Save(value);
-    Load(value);
+    CloneFrom(other);
 
     return *this;
 }
@@ -89,9 +736,17 @@ BP& BP::operator=(BP&& other)
     m_Nodes         = std::move(other.m_Nodes);
     m_Pins          = std::move(other.m_Pins);
     m_Context       = std::move(other.m_Context);
+    std::swap(m_Arena, other.m_Arena);  // nodes left in this go with old arena
 
     for (auto& node : m_Nodes)
+    {
         node->m_Blueprint = this;
+        node->m_EditEpoch = 0;
+    }
+    InvalidateIndex();
+    other.InvalidateIndex();
+    TouchLinks();
+    other.TouchLinks();
 
     return *this;
 }
@@ -132,14 +787,10 @@ void BP::DeleteNode(Node* node)
 
     if (node->m_GroupID)
     {
-        auto id = node->m_GroupID;
-        auto it = std::find_if(m_Nodes.begin(), m_Nodes.end(), [id](const Node* node)
+        auto group = FindNode(node->m_GroupID);
+        if (group)
         {
-            return node->m_ID == id;
-        });
-        if (it != m_Nodes.end())
-        {
-            (*it)->OnNodeDelete(node);
+            group->OnNodeDelete(node);
         }
     }
 
@@ -147,6 +798,7 @@ void BP::DeleteNode(Node* node)
     delete *nodeIt;
 
     m_Nodes.erase(nodeIt);
+    InvalidateIndex();
 }
 
 Node* BP::CloneNode(Node* node)
@@ -197,6 +849,8 @@ void BP::ForgetPin(Pin* pin)
         return;
 
     m_Pins.erase(pinIt);
+    InvalidateIndex();
+    EditLinkIndex(pin, pin->m_Link, 0);
 }
 
 void BP::Clear()
@@ -217,10 +871,21 @@ void BP::Clear()
         pin->m_Node = nullptr;
     }
     m_Pins.resize(0);
+    if (m_Arena)
+        m_Arena->Trim();
+    InvalidateIndex();
+    TouchLinks();
     m_Generator = IDGenerator();
     m_Context = Context();
 }
 
+BPArena* BP::GetArena()
+{
+    if (!m_Arena)
+        m_Arena = new BPArena();
+    return m_Arena;
+}
+
 span<Node*> BP::GetNodes()
 {
     return m_Nodes;
@@ -252,13 +917,22 @@ Node* BP::FindNode(ID_TYPE nodeId)
 
 const Node* BP::FindNode(ID_TYPE nodeId) const
 {
-    for (auto& node : m_Nodes)
-    {
-        if (node->m_ID == nodeId)
-            return node;
-    }
+    return FindIndexed(m_NodeIndex, m_NodeIndexValid, m_NodeIndexRevision, m_Nodes, nodeId);
+}
 
-    return nullptr;
+bool BP::GetNodeLatency(ID_TYPE nodeId, LatencyStats& stats) const
+{
+    auto node = FindNode(nodeId);
+    if (!node)
+        return false;
+    stats = node->m_Latency.GetStats();
+    return true;
+}
+
+void BP::ResetLatency()
+{
+    for (auto node : m_Nodes)
+        node->m_Latency.Reset();
 }
 
 Pin* BP::FindPin(ID_TYPE pinId)
@@ -266,15 +940,153 @@ Pin* BP::FindPin(ID_TYPE pinId)
     return const_cast<Pin*>(const_cast<const BP*>(this)->FindPin(pinId));
 }
 
-const Pin* BP::FindPin(ID_TYPE pinId) const
+const Pin* BP::FindPin(ID_TYPE pinId) const
+{
+    return FindIndexed(m_PinIndex, m_PinIndexValid, m_PinIndexRevision, m_Pins, pinId);
+}
+
+template <typename T>
+T* BP::FindIndexed(std::unordered_map<ID_TYPE, T*>& index, bool& valid, uint64_t& revision, const std::vector<T*>& items, ID_TYPE id) const
+{
+    // Code which rewrites IDs moves m_LinkRevision, and additions change the item count,
+    // so a miss in an index of current revision and size is authoritative.
+    {
+        std::shared_lock<std::shared_mutex> lock(m_IndexMutex);
+        if (valid)
+        {
+            auto it = index.find(id);
+            if (it != index.end() && it->second->m_ID == id)
+                return it->second;
+            if (it == index.end() && revision == m_LinkRevision && index.size() == items.size())
+                return nullptr;
+        }
+    }
+
+    // stale hit or index older than last ID change, rebuild once
+    std::unique_lock<std::shared_mutex> lock(m_IndexMutex);
+    auto current = m_LinkRevision.load();
+    if (!valid || revision != current || index.size() != items.size())
+    {
+        index.clear();
+        index.reserve(items.size());
+        for (auto item : items)
+            index.emplace(item->m_ID, item); // first one wins, as linear search did
+        valid = true;
+        revision = current;
+    }
+    auto it = index.find(id);
+    return it != index.end() && it->second->m_ID == id ? it->second : nullptr;
+}
+
+const Pin* BP::ResolveLink(const Pin& pin) const
+{
+    if (!pin.m_Link)
+        return nullptr;
+
+    {
+        std::shared_lock<std::shared_mutex> lock(m_FlatLinkMutex);
+        if (m_FlatLinkRevision == m_LinkRevision)
+        {
+            auto it = m_FlatLinks.find(pin.m_ID);
+            if (it != m_FlatLinks.end() && it->second.m_Link == pin.m_Link)
+                return it->second.m_Provider;
+        }
+    }
+
+    RebuildFlatLinks();
+
+    std::shared_lock<std::shared_mutex> lock(m_FlatLinkMutex);
+    auto it = m_FlatLinks.find(pin.m_ID);
+    if (it != m_FlatLinks.end() && it->second.m_Link == pin.m_Link)
+        return it->second.m_Provider;
+
+    // pin isn't owned by blueprint or was relinked without TouchLinks(), walk the chain
+    auto link = pin.GetLink(this);
+    for (size_t hops = 0; link && link->IsMappedPin() && hops < m_Pins.size(); hops++)
+        link = link->GetLink(this);
+    return link && !link->IsMappedPin() ? link : nullptr;
+}
+
+void BP::RebuildFlatLinks() const
+{
+    std::unique_lock<std::shared_mutex> lock(m_FlatLinkMutex);
+    uint64_t revision = m_LinkRevision;
+    if (m_FlatLinkRevision == revision)
+        return;
+
+    auto table_lock = LockPinTable();
+    auto& table = m_PinTable;
+    auto row_of = [&table](ID_TYPE id) -> int64_t
+    {
+        auto it = table.m_Row.find(id);
+        return it != table.m_Row.end() ? (int64_t)it->second : -1;
+    };
+    auto is_mapped = [&table](int64_t row)
+    {
+        return (table.m_Flags[row] & (PIN_FLAG_BRIDGE | PIN_FLAG_SHADOW)) != 0;
+    };
+
+    m_FlatLinks.clear();
+    m_FlatLinks.reserve(table.m_ID.size());
+    for (size_t i = 0; i < table.m_ID.size(); i++)
+    {
+        if (!table.m_Link[i])
+            continue;
+        auto row = row_of(table.m_Link[i]);
+        // hop limit guards against broken files with cyclic mapped pins
+        for (size_t hops = 0; row >= 0 && is_mapped(row) && hops < table.m_ID.size(); hops++)
+            row = table.m_Link[row] ? row_of(table.m_Link[row]) : -1;
+        Pin* link = row >= 0 && !is_mapped(row) ? table.m_Pin[row] : nullptr;
+        m_FlatLinks.emplace(table.m_ID[i], FlatLink{table.m_Link[i], link});
+    }
+    m_FlatLinkRevision = revision;
+}
+
+std::shared_lock<std::shared_mutex> BP::LockPinTable() const
 {
-    for (auto& pin : m_Pins)
     {
-        if (pin->m_ID == pinId)
-            return pin;
+        std::shared_lock<std::shared_mutex> lock(m_PinTableMutex);
+        if (m_PinTable.m_Revision == m_LinkRevision)
+            return lock;
+    }
+    {
+        std::unique_lock<std::shared_mutex> lock(m_PinTableMutex);
+        uint64_t revision = m_LinkRevision;
+        if (m_PinTable.m_Revision != revision)
+        {
+            auto& table = m_PinTable;
+            auto count = m_Pins.size();
+            table.m_ID.resize(count);
+            table.m_Link.resize(count);
+            table.m_Flags.resize(count);
+            table.m_Type.resize(count);
+            table.m_Node.resize(count);
+            table.m_Pin.assign(m_Pins.begin(), m_Pins.end());
+            table.m_Row.clear();
+            table.m_Row.reserve(count);
+            for (size_t i = 0; i < count; i++)
+            {
+                auto pin = m_Pins[i];
+                table.m_ID[i]       = pin->m_ID;
+                table.m_Link[i]     = pin->m_Link;
+                table.m_Flags[i]    = pin->m_Flags;
+                table.m_Type[i]     = pin->m_Type;
+                table.m_Node[i]     = pin->m_Node;
+                table.m_Row.emplace(pin->m_ID, (uint32_t)i);
+            }
+            table.m_Revision = revision;
+        }
     }
+    return std::shared_lock<std::shared_mutex>(m_PinTableMutex);
+}
 
-    return nullptr;
+void BP::InvalidateIndex()
+{
+    std::unique_lock<std::shared_mutex> lock(m_IndexMutex);
+    m_NodeIndexValid = false;
+    m_PinIndexValid = false;
+    m_NodeIndex.clear();
+    m_PinIndex.clear();
 }
 
 shared_ptr<NodeRegistry> BP::s_NodeRegistry = make_shared<NodeRegistry>();
@@ -521,26 +1333,11 @@ int BP::Load(const imgui_json::value& value)
     //IDGenerator generator;
     for (auto& nodeValue : *nodeArray)
     {
-        int ret = 0;
         ID_TYPE typeId;
         if (!imgui_json::GetTo<imgui_json::number>(nodeValue, "type_id", typeId)) // required
             return BP_ERR_NODE_LOAD;
 
-        auto node = s_NodeRegistry->Create(typeId, this);
-        if (!node)
-        {
-            // Create a Dummy node to replace real node
-            node = CreateDummyNode(nodeValue, this);
-            node->Load(nodeValue);
-        }
-        else if ((ret = node->Load(nodeValue)) != BP_ERR_NONE)
-        {
-            // Create a Dummy node to replace real node
-            node = CreateDummyNode(nodeValue, this);
-            node->Load(nodeValue);
-        }
-
-        m_Nodes.emplace_back(node);
+        m_Nodes.emplace_back(LoadNode(typeId, nodeValue));
     }
 
     const imgui_json::object* stateObject = nullptr;
@@ -552,55 +1349,164 @@ int BP::Load(const imgui_json::value& value)
         return BP_ERR_NODE_LOAD;
 
     m_Generator.SetState(generatorState);
+    TouchLinks(); // pins got their saved IDs and links
     m_IsOpen = true;
     return BP_ERR_NONE;
 }
 
-int BP::Import(const imgui_json::value& value, ImVec2 pos)
+Node* BP::LoadNode(ID_TYPE typeId, const imgui_json::value& nodeValue)
 {
-    if (!value.is_object())
-        return BP_ERR_GROUP_LOAD;
+    auto node = s_NodeRegistry->Create(typeId, this);
+    if (!node || node->Load(nodeValue) != BP_ERR_NONE)
+    {
+        // Create a Dummy node to replace real node
+        if (node) delete node;
+        node = CreateDummyNode(nodeValue, this);
+        node->Load(nodeValue);
+    }
+    return node;
+}
 
-    if (!value.contains("group") || !value.contains("status") || !value.contains("nodes"))
-        return BP_ERR_GROUP_LOAD;
+int BP::CloneFrom(const BP& other)
+{
+    Clear();
+
+    for (auto node : other.m_Nodes)
+    {
+        // pins keep their IDs, links are valid in the copy as they are
+        auto clone_node = node->Clone(this);
+        if (!clone_node)
+        {
+            // node has no structural clone, copy it through json as Load() does
+            imgui_json::value nodeValue;
+            nodeValue["type_id"] = imgui_json::number(node->GetTypeInfo().m_ID);
+            nodeValue["type_name"] = node->GetTypeInfo().m_Name;
+            node->Save(nodeValue);
+            clone_node = LoadNode(node->GetTypeInfo().m_ID, nodeValue);
+        }
+        m_Nodes.emplace_back(clone_node);
+    }
+
+    m_Generator.SetState(other.m_Generator.State());
+    TouchLinks();
+    m_IsOpen = true;
+    return BP_ERR_NONE;
+}
 
-    ID_TYPE typeId;
-    auto& groupValue = value["group"];
-    if (!imgui_json::GetTo<imgui_json::number>(groupValue, "type_id", typeId)) // required
+int BP::Import(const imgui_json::value& value, ImVec2 pos)
+{
+    GroupTemplate tmpl;
+    if (!tmpl.Build(value))
         return BP_ERR_GROUP_LOAD;
 
-    GroupNode *group_node = (GroupNode *)s_NodeRegistry->Create(typeId, this);
+    return Import(tmpl, pos);
+}
+
+int BP::Import(const GroupTemplate& tmpl, ImVec2 pos)
+{
+    GroupNode *group_node = (GroupNode *)s_NodeRegistry->Create(tmpl.m_TypeID, this);
     if (!group_node)
         return BP_ERR_GROUP_LOAD;
 
-    group_node->LoadGroup(value, pos);
+    group_node->LoadGroup(tmpl, pos);
     m_Nodes.emplace_back(group_node);
+    TouchLinks();
 
     return BP_ERR_NONE;
 }
 
-void BP::Save(imgui_json::value& value) const
+int BP::Import(std::string path, ImVec2 pos)
 {
-    auto& nodesValue = value["nodes"]; // required
-    nodesValue = imgui_json::array();
-    for (auto& node : m_Nodes)
-    {
-        imgui_json::value nodeValue;
+    auto file = GetGroupTemplate(path);
+    if (!file)
+        return BP_ERR_GROUP_LOAD;
+
+    return Import(file->m_Template, pos);
+}
 
+const imgui_json::value& BP::SaveNode(Node* node, imgui_json::value& scratch)
+{
+    auto save = [node](imgui_json::value& nodeValue)
+    {
+        nodeValue = imgui_json::value();
         nodeValue["type_id"] = imgui_json::number(node->GetTypeInfo().m_ID); // required
         nodeValue["type_name"] = node->GetTypeInfo().m_Name; // optional, to make data readable for humans
-
         node->Save(nodeValue);
+    };
 
-        nodesValue.push_back(nodeValue);
+    // node which doesn't report its edits is written every time, nothing is kept for it
+    if (!node->ReportsEdits())
+    {
+        save(scratch);
+        return scratch;
+    }
+
+    // clear the flag before Save(), a change made meanwhile marks the node again
+    if (node->m_Dirty.exchange(false) || node->m_SaveCache.is_null())
+    {
+        save(node->m_SaveCache);
+    }
+    return node->m_SaveCache;
+}
+
+void BP::MarkDirty()
+{
+    for (auto node : m_Nodes)
+        node->MarkDirty();
+}
+
+void BP::NoteEdit(Node* node)
+{
+    // epoch stamp keeps repeated edits of a node away from the lock
+    auto epoch = m_EditEpoch.load(std::memory_order_acquire);
+    if (node->m_EditEpoch.exchange(epoch, std::memory_order_acq_rel) == epoch)
+        return;
+    std::lock_guard<std::mutex> lock(m_EditMutex);
+    m_EditedNodes.push_back(node->m_ID);
+}
+
+std::vector<ID_TYPE> BP::TakeEditedNodes()
+{
+    std::vector<ID_TYPE> result;
+    std::lock_guard<std::mutex> lock(m_EditMutex);
+    result.swap(m_EditedNodes);
+    m_EditEpoch++;
+    return result;
+}
+
+void BP::Save(imgui_json::value& value)
+{
+    auto& nodesValue = value["nodes"]; // required
+    nodesValue = imgui_json::array();
+    auto& nodesArray = nodesValue.get<imgui_json::array>();
+    nodesArray.reserve(m_Nodes.size());
+    imgui_json::value scratch;
+    for (auto& node : m_Nodes)
+    {
+        nodesArray.push_back(SaveNode(node, scratch));
     }
 
-    auto& stateValue = value["state"]; // required
-    stateValue["generator_state"] = imgui_json::number(m_Generator.State()); // required
+    SaveState(value["state"]); // required
+}
+
+void BP::SaveState(imgui_json::value& value) const
+{
+    value["generator_state"] = imgui_json::number(m_Generator.State()); // required
 }
 
 int BP::Load(std::string path)
 {
+    // magic is enough to tell binary file, json file isn't mapped for it
+    uint32_t magic = 0;
+    size_t magicSize = 0;
+    if (auto file = fopen(path.c_str(), "rb"))
+    {
+        magicSize = fread(&magic, 1, sizeof(magic), file);
+        fclose(file);
+    }
+    if (IsBinary(&magic, magicSize))
+        return LoadBinary(path);
+
     auto value = imgui_json::value::load(path);
     if (!value.second)
         return -1;
@@ -608,56 +1514,250 @@ int BP::Load(std::string path)
     return Load(value.first);
 }
 
-bool BP::Save(std::string path) const
+bool BP::Save(std::string path)
 {
-    imgui_json::value value;
-    Save(value);
-    return value.save(path, 4);
+    auto file = fopen(path.c_str(), "wb");
+    if (!file)
+        return false;
+    bool ret;
+    {
+        JsonWriter writer(file, 4);
+        Save(writer);
+        ret = writer.Flush();
+    }
+    ret = (fclose(file) == 0) && ret;
+    return ret;
 }
 
-ID_TYPE BP::MakeNodeID(Node* node)
+void BP::Save(JsonWriter& writer)
 {
-    (void)node;
-    return m_Generator.GenerateID();
+    writer.BeginObject();
+    writer.Key("nodes"); // required
+    writer.BeginArray();
+    imgui_json::value scratch;
+    for (auto& node : m_Nodes)
+    {
+        writer.Value(SaveNode(node, scratch));
+    }
+    writer.EndArray();
+
+    writer.Key("state"); // required
+    writer.BeginObject();
+    writer.Key("generator_state"); // required
+    writer.Number(m_Generator.State());
+    writer.EndObject();
+    writer.EndObject();
 }
 
-ID_TYPE BP::MakePinID(Pin* pin)
+bool BP::IsBinary(const void* data, size_t size)
 {
-    if (pin) m_Pins.push_back(pin);
+    uint32_t magic = 0;
+    BinaryReader reader(data, size);
+    return reader.Read(magic) && magic == BP_BINARY_MAGIC;
+}
 
-    return m_Generator.GenerateID();
+static bool ReadBinaryHeader(BinaryReader& reader, uint32_t& generator_state, uint32_t& node_count)
+{
+    uint32_t magic = 0, version = 0;
+    if (!reader.Read(magic) || magic != BP_BINARY_MAGIC)
+        return false;
+    if (!reader.Read(version) || version > BP_BINARY_VERSION)
+        return false;
+    return reader.Read(generator_state) && reader.Read(node_count);
 }
 
-Pin * BP::GetPinFromID(ID_TYPE pinid)
+static bool ReadBinaryRecord(BinaryReader& reader, ID_TYPE& type_id, std::string& type_name, uint8_t& kind, BinaryReader& payload)
 {
-    if (m_Pins.empty())
-        return nullptr;
+    uint32_t payload_size = 0;
+    if (!reader.Read(type_id) || !reader.ReadString(type_name) || !reader.Read(kind) || !reader.Read(payload_size))
+        return false;
+    if (reader.Remain() < payload_size)
+        return false;
+    payload = reader.SubReader(payload_size);
+    return reader.Skip(payload_size);
+}
+
+int BP::LoadBinary(BinaryReader& reader)
+{
+    Clear();
+
+    uint32_t generatorState = 0, nodeCount = 0;
+    if (!ReadBinaryHeader(reader, generatorState, nodeCount))
+        return BP_ERR_BINARY_LOAD;
 
-    auto it = std::find_if(m_Pins.begin(), m_Pins.end(), [pinid](const Pin * const pin)
+    m_Nodes.reserve(nodeCount);
+    for (uint32_t i = 0; i < nodeCount; i++)
     {
-        return pin->m_ID == pinid;
-    });
-    if (it != m_Pins.end())
+        ID_TYPE typeId = 0;
+        std::string typeName;
+        uint8_t kind = 0;
+        BinaryReader payload(nullptr, 0);
+        if (!ReadBinaryRecord(reader, typeId, typeName, kind, payload))
+            return BP_ERR_BINARY_LOAD;
+
+        imgui_json::value nodeValue;
+        if (kind != BP_BINARY_RECORD_VALUE || !payload.ReadValue(nodeValue))
+            return BP_ERR_BINARY_LOAD;
+        auto node = s_NodeRegistry->Create(typeId, this);
+        if (!node || node->Load(nodeValue) != BP_ERR_NONE)
+        {
+            // Create a Dummy node to replace real node
+            if (node) delete node;
+            nodeValue["type_id"] = imgui_json::number(typeId);
+            nodeValue["type_name"] = typeName;
+            node = CreateDummyNode(nodeValue, this);
+            node->Load(nodeValue);
+        }
+
+        m_Nodes.emplace_back(node);
+    }
+
+    m_Generator.SetState(generatorState);
+    TouchLinks(); // pins got their saved IDs and links
+    m_IsOpen = true;
+    return BP_ERR_NONE;
+}
+
+void BP::SaveBinary(BinaryWriter& writer) const
+{
+    writer.Write<uint32_t>(BP_BINARY_MAGIC);
+    writer.Write<uint32_t>(BP_BINARY_VERSION);
+    writer.Write<uint32_t>(m_Generator.State());
+    writer.Write<uint32_t>((uint32_t)m_Nodes.size());
+    for (auto& node : m_Nodes)
+    {
+        auto typeInfo = node->GetTypeInfo();
+        writer.Write<ID_TYPE>(typeInfo.m_ID);
+        writer.WriteString(typeInfo.m_Name);
+        writer.Write<uint8_t>(BP_BINARY_RECORD_VALUE);
+        auto sizeOffset = writer.Size();
+        writer.Write<uint32_t>(0);
+        auto payloadOffset = writer.Size();
+        imgui_json::value nodeValue;
+        node->Save(nodeValue);
+        writer.WriteValue(nodeValue);
+        writer.Patch<uint32_t>(sizeOffset, (uint32_t)(writer.Size() - payloadOffset));
+    }
+}
+
+int BP::LoadBinary(std::string path)
+{
+    MappedFile file;
+    if (!file.Open(path))
+        return BP_ERR_BINARY_LOAD;
+
+    BinaryReader reader(file.Data(), file.Size());
+    return LoadBinary(reader);
+}
+
+bool BP::SaveBinary(std::string path) const
+{
+    BinaryWriter writer;
+    SaveBinary(writer);
+    return writer.Save(path);
+}
+
+int BP::JsonToBinary(const imgui_json::value& value, BinaryWriter& writer)
+{
+    const imgui_json::array* nodeArray = nullptr;
+    if (!value.is_object() || !imgui_json::GetPtrTo(value, "nodes", nodeArray)) // required
+        return BP_ERR_NODE_LOAD;
+    const imgui_json::object* stateObject = nullptr;
+    uint32_t generatorState = 0;
+    if (!imgui_json::GetPtrTo(value, "state", stateObject) || // required
+        !imgui_json::GetTo<imgui_json::number>(*stateObject, "generator_state", generatorState))
+        return BP_ERR_NODE_LOAD;
+
+    writer.Write<uint32_t>(BP_BINARY_MAGIC);
+    writer.Write<uint32_t>(BP_BINARY_VERSION);
+    writer.Write<uint32_t>(generatorState);
+    writer.Write<uint32_t>((uint32_t)nodeArray->size());
+    for (auto& nodeValue : *nodeArray)
     {
-        return *it;
+        ID_TYPE typeId = 0;
+        std::string typeName;
+        if (!imgui_json::GetTo<imgui_json::number>(nodeValue, "type_id", typeId)) // required
+            return BP_ERR_NODE_LOAD;
+        imgui_json::GetTo<imgui_json::string>(nodeValue, "type_name", typeName); // optional
+
+        // node payload is node value without type keys which are in record
+        imgui_json::value payloadValue = nodeValue;
+        payloadValue.erase("type_id");
+        payloadValue.erase("type_name");
+
+        writer.Write<ID_TYPE>(typeId);
+        writer.WriteString(typeName);
+        writer.Write<uint8_t>(BP_BINARY_RECORD_VALUE);
+        auto sizeOffset = writer.Size();
+        writer.Write<uint32_t>(0);
+        auto payloadOffset = writer.Size();
+        writer.WriteValue(payloadValue);
+        writer.Patch<uint32_t>(sizeOffset, (uint32_t)(writer.Size() - payloadOffset));
     }
-    return nullptr;
+    return BP_ERR_NONE;
 }
 
-const Pin * BP::GetPinFromID(ID_TYPE pinid) const
+int BP::BinaryToJson(BinaryReader& reader, imgui_json::value& value)
 {
-    if (m_Pins.empty())
-        return nullptr;
+    uint32_t generatorState = 0, nodeCount = 0;
+    if (!ReadBinaryHeader(reader, generatorState, nodeCount))
+        return BP_ERR_BINARY_LOAD;
 
-    auto it = std::find_if(m_Pins.begin(), m_Pins.end(), [pinid](const Pin * const pin)
+    auto& nodesValue = value["nodes"];
+    nodesValue = imgui_json::array();
+    for (uint32_t i = 0; i < nodeCount; i++)
     {
-        return pin->m_ID == pinid;
-    });
-    if (it != m_Pins.end())
+        ID_TYPE typeId = 0;
+        std::string typeName;
+        uint8_t kind = 0;
+        BinaryReader payload(nullptr, 0);
+        if (!ReadBinaryRecord(reader, typeId, typeName, kind, payload))
+            return BP_ERR_BINARY_LOAD;
+
+        imgui_json::value nodeValue;
+        if (kind != BP_BINARY_RECORD_VALUE || !payload.ReadValue(nodeValue))
+            return BP_ERR_BINARY_LOAD;
+        nodeValue["type_id"] = imgui_json::number(typeId);
+        nodeValue["type_name"] = typeName;
+        nodesValue.push_back(nodeValue);
+    }
+
+    auto& stateValue = value["state"];
+    stateValue["generator_state"] = imgui_json::number(generatorState);
+    return BP_ERR_NONE;
+}
+
+ID_TYPE BP::MakeNodeID(Node* node)
+{
+    (void)node;
+    return m_Generator.GenerateID();
+}
+
+ID_TYPE BP::MakePinID(Pin* pin)
+{
+    auto id = m_Generator.GenerateID();
+    if (pin)
     {
-        return *it;
+        m_Pins.push_back(pin);
+        {
+            std::unique_lock<std::shared_mutex> lock(m_IndexMutex);
+            if (m_PinIndexValid)
+                m_PinIndex.emplace(id, pin);
+        }
+        EditLinkIndex(pin, 0, pin->m_Link);
     }
-    return nullptr;
+
+    return id;
+}
+
+Pin * BP::GetPinFromID(ID_TYPE pinid)
+{
+    return FindPin(pinid);
+}
+
+const Pin * BP::GetPinFromID(ID_TYPE pinid) const
+{
+    return FindPin(pinid);
 }
 
 bool BP::HasPinAnyLink(const Pin& pin) const
@@ -673,17 +1773,74 @@ bool BP::HasPinAnyLink(const Pin& pin) const
 
 vector<Pin*> BP::FindPinsLinkedTo(const Pin& pin) const
 {
-    vector<Pin*> result;
-    for (auto& p : m_Pins)
+    // receivers only count when their link resolves to a pin of this blueprint
+    if (!pin.m_ID || !FindPin(pin.m_ID))
+        return {};
+    auto lock = LockLinkIndex();
+    auto it = m_LinkIndex.m_Receivers.find(pin.m_ID);
+    if (it == m_LinkIndex.m_Receivers.end())
+        return {};
+    return it->second;
+}
+
+void BP::UpdateLink(Pin& receiver, ID_TYPE oldLink)
+{
+    EditLinkIndex(&receiver, oldLink, receiver.m_Link);
+}
+
+void BP::EditLinkIndex(Pin* receiver, ID_TYPE oldLink, ID_TYPE newLink)
+{
+    std::unique_lock<std::shared_mutex> lock(m_LinkIndexMutex);
+    uint64_t revision = m_LinkIndex.m_Revision;
+    if (!m_LinkRevision.compare_exchange_strong(revision, revision + 1))
+    {
+        // index is stale already, next query rebuilds it
+        m_LinkRevision++;
+        return;
+    }
+    m_LinkIndex.m_Revision = revision + 1;
+    if (oldLink == newLink)
+        return;
+    if (oldLink)
+    {
+        auto it = m_LinkIndex.m_Receivers.find(oldLink);
+        if (it != m_LinkIndex.m_Receivers.end())
+        {
+            auto& receivers = it->second;
+            receivers.erase(std::remove(receivers.begin(), receivers.end(), receiver), receivers.end());
+            if (receivers.empty())
+                m_LinkIndex.m_Receivers.erase(it);
+        }
+    }
+    if (newLink)
+        m_LinkIndex.m_Receivers[newLink].push_back(receiver);
+}
+
+std::shared_lock<std::shared_mutex> BP::LockLinkIndex() const
+{
     {
-        auto linkedPin = p->GetLink(this);
-        if(std::find(m_Pins.begin(), m_Pins.end(), linkedPin) != m_Pins.end())
+        std::shared_lock<std::shared_mutex> lock(m_LinkIndexMutex);
+        if (m_LinkIndex.m_Revision == m_LinkRevision)
+            return lock;
+    }
+    {
+        std::unique_lock<std::shared_mutex> lock(m_LinkIndexMutex);
+        uint64_t revision = m_LinkRevision;
+        if (m_LinkIndex.m_Revision != revision)
         {
-            if (linkedPin && linkedPin->m_ID == pin.m_ID)
-                result.push_back(p);
+            auto table_lock = LockPinTable();
+            auto& table = m_PinTable;
+            m_LinkIndex.m_Receivers.clear();
+            for (size_t i = 0, count = table.m_Link.size(); i < count; i++)
+            {
+                if (table.m_Link[i])
+                    m_LinkIndex.m_Receivers[table.m_Link[i]].push_back(table.m_Pin[i]);
+            }
+            // table may be newer than revision read above, then next query rebuilds again
+            m_LinkIndex.m_Revision = std::min<uint64_t>(revision, table.m_Revision);
         }
     }
-    return result;
+    return std::shared_lock<std::shared_mutex>(m_LinkIndexMutex);
 }
 
 void BP::ResetState()
@@ -695,6 +1852,135 @@ void BP::ResetState()
 }
 # pragma endregion
 
+// ---------------------------
+// -----[ BPInstancePool ]----
+// ---------------------------
+# pragma region BPInstancePool
+BPInstancePool::~BPInstancePool()
+{
+    Clear();
+}
+
+int BPInstancePool::Load(std::string path)
+{
+    Clear();
+    return m_Template.Load(path);
+}
+
+int BPInstancePool::Load(const imgui_json::value& value)
+{
+    Clear();
+    return m_Template.Load(value);
+}
+
+BP* BPInstancePool::CreateInstance()
+{
+    auto instance = new BP(m_Template);
+    m_Instances.push_back(instance);
+    return instance;
+}
+
+void BPInstancePool::RestoreInstance(BP* instance)
+{
+    // instance is a structural copy of template, nodes and pins are in same order. Node state
+    // and pins are reset the way Clone() copies them, an instance which doesn't match template
+    // any more is built again
+    instance->Stop();
+    auto templateNodes = m_Template.GetNodes();
+    auto instanceNodes = instance->GetNodes();
+    // CopyTo() keeps a link where template pin has none and pin copy fails on other value type
+    // (AnyPin inner pin), relinked or retyped instance is built again too
+    auto sameLinks = [](span<Pin*> src, span<Pin*> dst)
+    {
+        if (src.size() != dst.size())
+            return false;
+        for (size_t i = 0; i < src.size(); i++)
+        {
+            if (src[i]->m_Link != dst[i]->m_Link || src[i]->m_LinkFrom != dst[i]->m_LinkFrom ||
+                src[i]->m_Type != dst[i]->m_Type || src[i]->GetValueType() != dst[i]->GetValueType())
+                return false;
+        }
+        return true;
+    };
+    bool restored = templateNodes.size() == instanceNodes.size();
+    for (size_t i = 0; restored && i < templateNodes.size(); i++)
+    {
+        auto templateNode = templateNodes[i];
+        auto node = instanceNodes[i];
+        restored = node->m_ID == templateNode->m_ID &&
+                   node->GetTypeInfo().m_ID == templateNode->GetTypeInfo().m_ID &&
+                   sameLinks(templateNode->GetInputPins(), node->GetInputPins()) &&
+                   sameLinks(templateNode->GetOutputPins(), node->GetOutputPins()) &&
+                   templateNode->CopyTo(*node);
+    }
+    if (restored)
+        instance->TouchLinks();
+    else
+        instance->CloneFrom(m_Template);
+}
+
+BP* BPInstancePool::Acquire()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        if (!m_FreeInstances.empty())
+        {
+            auto instance = m_FreeInstances.back();
+            m_FreeInstances.pop_back();
+            return instance;
+        }
+    }
+    // template is only read, copying it doesn't hold up other clips
+    auto instance = new BP(m_Template);
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_Instances.push_back(instance);
+    return instance;
+}
+
+void BPInstancePool::Release(BP* instance)
+{
+    if (!instance)
+        return;
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        if (std::find(m_Instances.begin(), m_Instances.end(), instance) == m_Instances.end())
+            return;
+    }
+    // instance stays with caller until it is back in free list, restore runs without lock
+    RestoreInstance(instance);
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_FreeInstances.push_back(instance);
+}
+
+void BPInstancePool::Reserve(size_t count)
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    while (m_Instances.size() < count)
+        m_FreeInstances.push_back(CreateInstance());
+}
+
+void BPInstancePool::Clear()
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    for (auto instance : m_Instances)
+        delete instance;
+    m_Instances.clear();
+    m_FreeInstances.clear();
+}
+
+size_t BPInstancePool::GetInstanceCount() const
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    return m_Instances.size();
+}
+
+size_t BPInstancePool::GetFreeCount() const
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    return m_FreeInstances.size();
+}
+# pragma endregion
+
 # pragma region Action
 Action::Action(std::string name, std::string icon, OnTriggeredEvent::Delegate delegate)
     : m_Name(name), m_Icon(icon)
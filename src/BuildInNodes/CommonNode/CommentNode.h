@@ -6,5 +6,6 @@ struct CommentNode final : Node
 {
     BP_NODE(CommentNode, VERSION_BLUEPRINT, VERSION_BLUEPRINT_API, NodeType::Internal, NodeStyle::Comment, "System")
     CommentNode(BP* blueprint): Node(blueprint) { m_Name = "Comment"; }
+    Node* Clone(BP* blueprint, const std::map<ID_TYPE, ID_TYPE>& MapID = {}) override { return CloneAs<CommentNode>(blueprint, MapID); }
 };
 } // namespace BluePrint
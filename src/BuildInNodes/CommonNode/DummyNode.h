@@ -14,14 +14,14 @@ struct DummyNode final : Node
 
     Pin* InsertInputPin(PinType type, const std::string name) override
     {
-        Pin* pin = new Pin(this, type, name);
+        Pin* pin = new (m_Blueprint) Pin(this, type, name);
         m_InputPins.push_back(pin);
         return pin;
     }
 
     Pin* InsertOutputPin(PinType type, const std::string name) override
     {
-        Pin* pin = new Pin(this, type, name);
+        Pin* pin = new (m_Blueprint) Pin(this, type, name);
         m_OutputPins.push_back(pin);
         return pin;
     }
@@ -69,7 +69,7 @@ struct DummyNode final : Node
     span<Pin*> GetInputPins() override { return m_InputPins; }
     span<Pin*> GetOutputPins() override { return m_OutputPins; }
     int  Load(const imgui_json::value& value) override { m_node_value = value; return BP_ERR_NONE; };
-    void Save(imgui_json::value& value, std::map<ID_TYPE, ID_TYPE> MapID = {}) override { value = m_node_value; };
+    void Save(imgui_json::value& value, const std::map<ID_TYPE, ID_TYPE>& MapID = {}) override { value = m_node_value; };
 
     std::vector<Pin *> m_InputPins;
     std::vector<Pin *> m_OutputPins;
@@ -8,6 +8,104 @@ namespace edd = ax::NodeEditor::Detail;
         pin_name + "$" + node_name + "$" + node_type
 namespace BluePrint
 {
+// Exported group file in the shape GroupNode::LoadGroup() consumes. ID lists and node status are
+// gathered once, so importing same file again only allocates new IDs and creates nodes.
+// Points into the json it was built from, which must outlive it.
+struct GroupTemplate
+{
+    struct Member
+    {
+        const imgui_json::value*    m_Value {nullptr};  // node record
+        ID_TYPE                     m_TypeID {0};       // 0 if record has no type, node is skipped
+        ID_TYPE                     m_ID {0};           // saved node ID
+        std::vector<ID_TYPE>        m_PinIDs;           // saved pin IDs, Any pin inner IDs included
+        ImVec2                      m_Location;         // relative to group position
+        ImVec2                      m_Size;
+    };
+
+    const imgui_json::value*    m_GroupValue {nullptr};
+    ID_TYPE                     m_TypeID {0};
+    ID_TYPE                     m_ID {0};               // saved group ID
+    std::vector<ID_TYPE>        m_PinIDs;               // saved bridge and shadow pin IDs
+    ImVec2                      m_NodeSize;
+    ImVec2                      m_GroupSize;
+    std::vector<Member>         m_Members;
+
+    static inline void GetPinIDs(const imgui_json::array* pinsArray, std::vector<ID_TYPE>& ids)
+    {
+        if (!pinsArray)
+            return;
+        for (auto& pinValue : *pinsArray)
+        {
+            ID_TYPE object_id = 0;
+            imgui_json::GetTo<imgui_json::number>(pinValue, "id", object_id);
+            ids.push_back(object_id);
+            if (pinValue.contains("inner"))
+            {
+                auto& innerValue = pinValue["inner"];
+                imgui_json::GetTo<imgui_json::number>(innerValue, "id", object_id);
+                ids.push_back(object_id);
+            }
+        }
+    }
+
+    inline bool Build(const imgui_json::value& value)
+    {
+        if (!value.is_object())
+            return false;
+
+        if (!value.contains("group") || !value.contains("status") || !value.contains("nodes"))
+            return false;
+
+        auto& groupValue = value["group"];
+        auto& statusValue = value["status"];
+        if (!imgui_json::GetTo<imgui_json::number>(groupValue, "type_id", m_TypeID)) // required
+            return false;
+
+        m_GroupValue = &groupValue;
+        imgui_json::GetTo<imgui_json::number>(groupValue, "id", m_ID);
+        const imgui_json::array* pinsArray = nullptr;
+        if (imgui_json::GetPtrTo(groupValue, "input_pins", pinsArray))
+            GetPinIDs(pinsArray, m_PinIDs);
+        if (imgui_json::GetPtrTo(groupValue, "output_pins", pinsArray))
+            GetPinIDs(pinsArray, m_PinIDs);
+        if (imgui_json::GetPtrTo(groupValue, "input_shadow_pins", pinsArray)) // optional
+            GetPinIDs(pinsArray, m_PinIDs);
+        if (imgui_json::GetPtrTo(groupValue, "output_shadow_pins", pinsArray)) // optional
+            GetPinIDs(pinsArray, m_PinIDs);
+
+        auto& groupStatus = statusValue[edd::Serialization::ToString((const ed::NodeId)(m_ID))];
+        imgui_json::GetTo<imgui_json::number>(groupStatus["size"], "x", m_NodeSize.x);
+        imgui_json::GetTo<imgui_json::number>(groupStatus["size"], "y", m_NodeSize.y);
+        imgui_json::GetTo<imgui_json::number>(groupStatus["group_size"], "x", m_GroupSize.x);
+        imgui_json::GetTo<imgui_json::number>(groupStatus["group_size"], "y", m_GroupSize.y);
+
+        const imgui_json::array* nodeArray = nullptr;
+        if (imgui_json::GetPtrTo(value, "nodes", nodeArray))
+        {
+            m_Members.reserve(nodeArray->size());
+            for (auto& nodeValue : *nodeArray)
+            {
+                Member member;
+                member.m_Value = &nodeValue;
+                imgui_json::GetTo<imgui_json::number>(nodeValue, "type_id", member.m_TypeID);
+                imgui_json::GetTo<imgui_json::number>(nodeValue, "id", member.m_ID);
+                if (imgui_json::GetPtrTo(nodeValue, "input_pins", pinsArray))
+                    GetPinIDs(pinsArray, member.m_PinIDs);
+                if (imgui_json::GetPtrTo(nodeValue, "output_pins", pinsArray))
+                    GetPinIDs(pinsArray, member.m_PinIDs);
+                auto& nodeStatus = statusValue[edd::Serialization::ToString((const ed::NodeId)(member.m_ID))];
+                imgui_json::GetTo<imgui_json::number>(nodeStatus["location"], "x", member.m_Location.x);
+                imgui_json::GetTo<imgui_json::number>(nodeStatus["location"], "y", member.m_Location.y);
+                imgui_json::GetTo<imgui_json::number>(nodeStatus["size"], "x", member.m_Size.x);
+                imgui_json::GetTo<imgui_json::number>(nodeStatus["size"], "y", member.m_Size.y);
+                m_Members.push_back(std::move(member));
+            }
+        }
+        return true;
+    }
+};
+
 struct GroupNode final : Node
 {
     BP_NODE(GroupNode, VERSION_BLUEPRINT, VERSION_BLUEPRINT_API, NodeType::Internal, NodeStyle::Group, "System")
@@ -72,7 +170,7 @@ struct GroupNode final : Node
 
     inline void AddInputMapPin(Pin * pin)
     {
-        if (std::find(m_InputMapPins.begin(), m_InputMapPins.end(), pin) == m_InputMapPins.end())
+        if (m_InputMapPinSet.insert(pin).second)
         {
             m_InputMapPins.push_back(pin);
         }
@@ -80,115 +178,142 @@ struct GroupNode final : Node
 
     inline void AddOutputMapPin(Pin * pin)
     {
-        if (std::find(m_OutputMapPins.begin(), m_OutputMapPins.end(), pin) == m_OutputMapPins.end())
+        if (m_OutputMapPinSet.insert(pin).second)
         {
             m_OutputMapPins.push_back(pin);
         }
     }
 
+    inline bool EraseMapPin(std::vector<Pin *>& pins, std::unordered_set<Pin *>& pin_set, Pin * pin)
+    {
+        if (!pin_set.erase(pin))
+            return false;
+        pins.erase(std::find(pins.begin(), pins.end(), pin));
+        return true;
+    }
+
+    inline Pin * FindMappedPin(const std::unordered_map<ID_TYPE, Pin *>& index, ID_TYPE pid)
+    {
+        auto it = index.find(pid);
+        return it != index.end() ? it->second : nullptr;
+    }
+
+    // Remove bridge/shadow pin from its vector and mapped pin index, false if it isn't ours
+    inline bool EraseMappedPin(std::vector<Pin *>& pins, std::unordered_map<ID_TYPE, Pin *>& index, Pin * pin)
+    {
+        auto it = index.find(pin->m_MappedPin);
+        if (it == index.end() || it->second != pin)
+            return false;
+        index.erase(it);
+        pins.erase(std::find(pins.begin(), pins.end(), pin));
+        return true;
+    }
+
+    void RebuildIndex()
+    {
+        auto build = [](const std::vector<Pin *>& pins, std::unordered_map<ID_TYPE, Pin *>& index)
+        {
+            index.clear();
+            for (auto pin : pins) index.emplace(pin->m_MappedPin, pin);
+        };
+        build(m_InputBridgePins, m_InputBridgeIndex);
+        build(m_InputShadowPins, m_InputShadowIndex);
+        build(m_OutputBridgePins, m_OutputBridgeIndex);
+        build(m_OutputShadowPins, m_OutputShadowIndex);
+        m_InputMapPinSet = std::unordered_set<Pin *>(m_InputMapPins.begin(), m_InputMapPins.end());
+        m_OutputMapPinSet = std::unordered_set<Pin *>(m_OutputMapPins.begin(), m_OutputMapPins.end());
+        m_GroupNodeSet = std::unordered_set<Node *>(m_GroupNodes.begin(), m_GroupNodes.end());
+        m_ScanRevision = static_cast<uint64_t>(-1);
+    }
+
     inline bool AddInputPin(Pin * pin, Pin **bridge_pin, Pin **shadow_pin)
     {
         bool is_exist = false;
         string pin_name = EXPORT_PIN_NAME(pin->m_Name, pin->m_Node->m_Name, pin->m_Node->GetTypeInfo().m_NodeTypeName);
-        std::vector<Pin *>::iterator it;
         ID_TYPE pid = pin->m_ID;
         // Try to Create Bridge Pin
         std::string bridge_name = pin_name + "$Bridge$In";
-        it = std::find_if(m_InputBridgePins.begin(), m_InputBridgePins.end(), [pid](Pin * const pin)
-        {
-            return pin->m_MappedPin == pid;
-        });
-        if (it == m_InputBridgePins.end())
+        auto bridge_it = m_InputBridgeIndex.find(pid);
+        if (bridge_it == m_InputBridgeIndex.end())
         {
             if (pin->m_Type == PinType::Custom)
             {
                 CustomPin* cuspin = reinterpret_cast<CustomPin*>(pin);
-                *bridge_pin = new CustomPin(this, cuspin->GetPinEx().GetTypeEx().GetName(), bridge_name);
+                *bridge_pin = new (m_Blueprint) CustomPin(this, cuspin->GetPinEx().GetTypeEx().GetName(), bridge_name);
             }
             else if (pin->m_Type == PinType::Any)
             {
                 AnyPin * any_pin = reinterpret_cast<AnyPin *>(pin);
-                AnyPin * b_pin = new AnyPin(this, bridge_name);
+                AnyPin * b_pin = new (m_Blueprint) AnyPin(this, bridge_name);
                 if (any_pin->m_InnerPin) b_pin->SetValueType(any_pin->GetValueType());
                 *bridge_pin = b_pin;
             }
             else
             {
-                *bridge_pin = new Pin(this, pin->m_Type, bridge_name);
+                *bridge_pin = new (m_Blueprint) Pin(this, pin->m_Type, bridge_name);
             }
             (*bridge_pin)->m_MappedPin = pin->m_ID;
             (*bridge_pin)->m_Flags = PIN_FLAG_BRIDGE | PIN_FLAG_IN;
             m_InputBridgePins.push_back(*bridge_pin);
+            m_InputBridgeIndex.emplace(pid, *bridge_pin);
+            std::sort(m_InputBridgePins.begin(), m_InputBridgePins.end(), [](const Pin * a, const Pin * b) { return a->m_MappedPin < b->m_MappedPin; });
         }
         else
         {
-            *bridge_pin = *it;
+            *bridge_pin = bridge_it->second;
             is_exist = true;
         }
         // Try to Create Shadow Pin
         std::string shadow_name = pin_name + "$Shadow$In";
-        it = std::find_if(m_InputShadowPins.begin(), m_InputShadowPins.end(), [pid](Pin * const pin)
-        {
-            return pin->m_MappedPin == pid;
-        });
-        if (it == m_InputShadowPins.end())
+        auto shadow_it = m_InputShadowIndex.find(pid);
+        if (shadow_it == m_InputShadowIndex.end())
         {
             if (pin->m_Type == PinType::Custom)
             {
                 CustomPin* cuspin = reinterpret_cast<CustomPin*>(pin);
-                *shadow_pin = new CustomPin(this, cuspin->GetPinEx().GetTypeEx().GetName(), shadow_name);
+                *shadow_pin = new (m_Blueprint) CustomPin(this, cuspin->GetPinEx().GetTypeEx().GetName(), shadow_name);
             }
             else if (pin->m_Type == PinType::Any)
             {
                 AnyPin * any_pin = reinterpret_cast<AnyPin *>(pin);
-                AnyPin * s_pin = new AnyPin(this, shadow_name);
+                AnyPin * s_pin = new (m_Blueprint) AnyPin(this, shadow_name);
                 if (any_pin->m_InnerPin) s_pin->SetValueType(any_pin->GetValueType());
                 *shadow_pin = s_pin;
             }
             else
             {
-                *shadow_pin = new Pin(this, pin->m_Type, shadow_name);;
+                *shadow_pin = new (m_Blueprint) Pin(this, pin->m_Type, shadow_name);;
             }
             (*shadow_pin)->m_MappedPin = pin->m_ID;
             (*shadow_pin)->m_Flags = PIN_FLAG_SHADOW | PIN_FLAG_IN;
             m_InputShadowPins.push_back(*shadow_pin);
+            m_InputShadowIndex.emplace(pid, *shadow_pin);
         }
         else
         {
-            *shadow_pin = *it;
+            *shadow_pin = shadow_it->second;
             is_exist = true;
         }
 
-        std::sort(m_InputBridgePins.begin(), m_InputBridgePins.end(), [](const Pin * a, const Pin * b) { return a->m_MappedPin < b->m_MappedPin; });
-
         return is_exist;
     }
 
     inline void RemoveInputPin(Pin * pin, bool rebuild_link = true)
     {
-        std::vector<Pin *>::iterator it;
         Pin * bridge_pin = nullptr;
         Pin * shadow_pin = nullptr;
         ID_TYPE pid = pin->m_ID;
         // Try to Remove Bridge Pin
-        it = std::find_if(m_InputBridgePins.begin(), m_InputBridgePins.end(), [pid](Pin * const pin)
+        bridge_pin = FindMappedPin(m_InputBridgeIndex, pid);
+        if (bridge_pin)
         {
-            return pin->m_MappedPin == pid;
-        });
-        if (it != m_InputBridgePins.end())
-        {
-            bridge_pin = *it;
-            m_InputBridgePins.erase(it);
+            EraseMappedPin(m_InputBridgePins, m_InputBridgeIndex, bridge_pin);
         }
         // Try to Remove Shadow Pin
-        it = std::find_if(m_InputShadowPins.begin(), m_InputShadowPins.end(), [pid](Pin * const pin)
-        {
-            return pin->m_MappedPin == pid;
-        });
-        if (it != m_InputShadowPins.end())
+        shadow_pin = FindMappedPin(m_InputShadowIndex, pid);
+        if (shadow_pin)
         {
-            shadow_pin = *it;
-            m_InputShadowPins.erase(it);
+            EraseMappedPin(m_InputShadowPins, m_InputShadowIndex, shadow_pin);
         }
         if (!bridge_pin || !shadow_pin)
             return;
@@ -223,110 +348,95 @@ struct GroupNode final : Node
         }
         delete shadow_pin;
         delete bridge_pin;
-        std::sort(m_InputBridgePins.begin(), m_InputBridgePins.end(), [](const Pin * a, const Pin * b) { return a->m_MappedPin < b->m_MappedPin; });
     }
 
     inline bool AddOutputPin(Pin * pin, Pin **bridge_pin, Pin **shadow_pin)
     {
         bool is_exist = false;
         string pin_name = EXPORT_PIN_NAME(pin->m_Name, pin->m_Node->m_Name, pin->m_Node->GetTypeInfo().m_NodeTypeName);
-        std::vector<Pin *>::iterator it;
         ID_TYPE pid = pin->m_ID;
         // Try to Create Bridge Pin
         std::string bridge_name = pin_name + "$Bridge$Out";
-        it = std::find_if(m_OutputBridgePins.begin(), m_OutputBridgePins.end(), [pid](Pin * const pin)
-        {
-            return pin->m_MappedPin == pid;
-        });
-        if (it == m_OutputBridgePins.end())
+        auto bridge_it = m_OutputBridgeIndex.find(pid);
+        if (bridge_it == m_OutputBridgeIndex.end())
         {
             if (pin->m_Type == PinType::Custom)
             {
                 CustomPin* cuspin = reinterpret_cast<CustomPin*>(pin);
-                *bridge_pin = new CustomPin(this, cuspin->GetPinEx().GetTypeEx().GetName(), bridge_name);
+                *bridge_pin = new (m_Blueprint) CustomPin(this, cuspin->GetPinEx().GetTypeEx().GetName(), bridge_name);
             }
             else if (pin->m_Type == PinType::Any)
             {
                 AnyPin * any_pin = reinterpret_cast<AnyPin *>(pin);
-                AnyPin * b_pin = new AnyPin(this, bridge_name);
+                AnyPin * b_pin = new (m_Blueprint) AnyPin(this, bridge_name);
                 if (any_pin->m_InnerPin) b_pin->SetValueType(any_pin->GetValueType());
                 *bridge_pin = b_pin;
             }
             else
             {
-                *bridge_pin = new Pin(this, pin->m_Type, bridge_name);;
+                *bridge_pin = new (m_Blueprint) Pin(this, pin->m_Type, bridge_name);;
             }
             (*bridge_pin)->m_MappedPin = pin->m_ID;
             (*bridge_pin)->m_Flags = PIN_FLAG_BRIDGE | PIN_FLAG_OUT;
             m_OutputBridgePins.push_back(*bridge_pin);
+            m_OutputBridgeIndex.emplace(pid, *bridge_pin);
+            std::sort(m_OutputBridgePins.begin(), m_OutputBridgePins.end(), [](const Pin * a, const Pin * b) { return a->m_MappedPin < b->m_MappedPin; });
         }
         else
         {
-            *bridge_pin = *it;
+            *bridge_pin = bridge_it->second;
             is_exist = true;
         }
         // Try to Create Shadow Pin
         std::string shadow_name = pin_name + "$Shadow$Out";
-        it = std::find_if(m_OutputShadowPins.begin(), m_OutputShadowPins.end(), [pid](Pin * const pin)
-        {
-            return pin->m_MappedPin == pid;
-        });
-        if (it == m_OutputShadowPins.end())
+        auto shadow_it = m_OutputShadowIndex.find(pid);
+        if (shadow_it == m_OutputShadowIndex.end())
         {
             if (pin->m_Type == PinType::Custom)
             {
                 CustomPin* cuspin = reinterpret_cast<CustomPin*>(pin);
-                *shadow_pin = new CustomPin(this, cuspin->GetPinEx().GetTypeEx().GetName(), shadow_name);
+                *shadow_pin = new (m_Blueprint) CustomPin(this, cuspin->GetPinEx().GetTypeEx().GetName(), shadow_name);
             }
             else if (pin->m_Type == PinType::Any)
             {
                 AnyPin * any_pin = reinterpret_cast<AnyPin *>(pin);
-                AnyPin * s_pin = new AnyPin(this, shadow_name);
+                AnyPin * s_pin = new (m_Blueprint) AnyPin(this, shadow_name);
                 if (any_pin->m_InnerPin) s_pin->SetValueType(any_pin->GetValueType());
                 *shadow_pin = s_pin;
             }
             else
             {
-                *shadow_pin = new Pin(this, pin->m_Type, shadow_name);
+                *shadow_pin = new (m_Blueprint) Pin(this, pin->m_Type, shadow_name);
             }
             (*shadow_pin)->m_MappedPin = pin->m_ID;
             (*shadow_pin)->m_Flags = PIN_FLAG_SHADOW | PIN_FLAG_OUT;
             m_OutputShadowPins.push_back(*shadow_pin);
+            m_OutputShadowIndex.emplace(pid, *shadow_pin);
         }
         else
         {
-            *shadow_pin = *it;
+            *shadow_pin = shadow_it->second;
             is_exist = true;
         }
-        std::sort(m_OutputBridgePins.begin(), m_OutputBridgePins.end(), [](const Pin * a, const Pin * b) { return a->m_MappedPin < b->m_MappedPin; });
         return is_exist;
     }
 
     inline void RemoveOutputPin(Pin * pin, bool rebuild_link = true)
     {
-        std::vector<Pin *>::iterator it;
         ID_TYPE pid = pin->m_ID;
         Pin * bridge_pin = nullptr;
         Pin * shadow_pin = nullptr;
         // Try to Remove Bridge Pin
-        it = std::find_if(m_OutputBridgePins.begin(), m_OutputBridgePins.end(), [pid](Pin * const pin)
-        {
-            return pin->m_MappedPin == pid;
-        });
-        if (it != m_OutputBridgePins.end())
+        bridge_pin = FindMappedPin(m_OutputBridgeIndex, pid);
+        if (bridge_pin)
         {
-            bridge_pin = *it;
-            m_OutputBridgePins.erase(it);
+            EraseMappedPin(m_OutputBridgePins, m_OutputBridgeIndex, bridge_pin);
         }
         // Try to Remove Shadow Pin
-        it = std::find_if(m_OutputShadowPins.begin(), m_OutputShadowPins.end(), [pid](Pin * const pin)
+        shadow_pin = FindMappedPin(m_OutputShadowIndex, pid);
+        if (shadow_pin)
         {
-            return pin->m_MappedPin == pid;
-        });
-        if (it != m_OutputShadowPins.end())
-        {
-            shadow_pin = *it;
-            m_OutputShadowPins.erase(it);
+            EraseMappedPin(m_OutputShadowPins, m_OutputShadowIndex, shadow_pin);
         }
         if (!bridge_pin || !shadow_pin)
             return;
@@ -360,21 +470,46 @@ struct GroupNode final : Node
         }
         delete shadow_pin;
         delete bridge_pin;
-        std::sort(m_OutputBridgePins.begin(), m_OutputBridgePins.end(), [](const Pin * a, const Pin * b) { return a->m_MappedPin < b->m_MappedPin; });
     }
 
     void ScanAllPins()
     {
         m_mutex.lock();
         auto nodes = m_Dragging ? m_GroupNodes : GetGroupedNodes(*this);
+        std::unordered_set<Node *> node_set(nodes.begin(), nodes.end());
+        // Scan result only depends on membership and links, skip it when none of them changed
+        // since last scan. Revision is taken before scan, so links made by the scan itself are
+        // checked once more on next call.
+        auto revision = m_Blueprint->GetLinkRevision();
+        bool same_nodes = node_set.size() == m_GroupNodeSet.size() &&
+                          std::all_of(nodes.begin(), nodes.end(), [this](Node * node) { return m_GroupNodeSet.count(node) != 0; });
+        if (same_nodes && revision == m_ScanRevision)
+        {
+            ed::SetNodeZPosition(m_ID, m_ZPos);
+            for (auto node : m_GroupNodes)
+                ed::SetNodeZPosition(node->m_ID, m_ZPos + 1);
+            m_mutex.unlock();
+            return;
+        }
+        m_ScanRevision = revision;
+        // pin flags are saved with member records, nodes whose flags the scan changes are marked dirty
+        std::vector<std::pair<Pin *, ID_TYPE>> member_flags;
+        auto keep_flags = [&member_flags](Node * node)
+        {
+            for (auto pin : node->GetInputPins())  member_flags.emplace_back(pin, pin->m_Flags);
+            for (auto pin : node->GetOutputPins()) member_flags.emplace_back(pin, pin->m_Flags);
+        };
+        for (auto node : nodes) keep_flags(node);
+        for (auto node : m_GroupNodes) if (!node_set.count(node)) keep_flags(node);
         for (auto node : nodes)
         {
             // mark node
             if (!m_Dragging)
             {
-                if (std::find(m_GroupNodes.begin(), m_GroupNodes.end(), node) == m_GroupNodes.end())
+                if (m_GroupNodeSet.insert(node).second)
                 {
                     node->m_GroupID = m_ID;
+                    node->MarkDirty();
                     ed::SetNodeGroupID(node->m_ID, m_ID);
                     m_GroupNodes.push_back(node);
                 }
@@ -414,22 +549,18 @@ struct GroupNode final : Node
                                 // 4. link inside pin with current pin
                                 in_link->LinkTo(*pin);
                                 // 5. delete shadow/bridge pin
-                                auto it_b = std::find(m_OutputBridgePins.begin(), m_OutputBridgePins.end(), link);
-                                if (it_b != m_OutputBridgePins.end())
+                                if (EraseMappedPin(m_OutputBridgePins, m_OutputBridgeIndex, link))
                                 {
-                                    m_OutputBridgePins.erase(it_b);
                                     link->Unlink();
                                     delete link;
                                 }
-                                auto it_s = std::find(m_OutputShadowPins.begin(), m_OutputShadowPins.end(), shadow_pin);
-                                if (it_s != m_OutputShadowPins.end())
+                                if (EraseMappedPin(m_OutputShadowPins, m_OutputShadowIndex, shadow_pin))
                                 {
-                                    m_OutputShadowPins.erase(it_s);
                                     shadow_pin->Unlink();
                                     delete shadow_pin;
                                 }
                             }
-                            else if (std::find(nodes.begin(), nodes.end(), linked_node) != nodes.end())
+                            else if (node_set.count(linked_node))
                             {
                                 // flow input pin link with inside
                                 if (link->m_Link != pin->m_ID)
@@ -558,23 +689,19 @@ struct GroupNode final : Node
                             // 5. if bridge out pin linkfrom size is 0, delete shadow/bridge pin
                             if (link->m_LinkFrom.size() <= 0)
                             {
-                                auto it_b = std::find(m_OutputBridgePins.begin(), m_OutputBridgePins.end(), link);
-                                if (it_b != m_OutputBridgePins.end())
+                                if (EraseMappedPin(m_OutputBridgePins, m_OutputBridgeIndex, link))
                                 {
-                                    m_OutputBridgePins.erase(it_b);
                                     link->Unlink();
                                     delete link;
                                 }
-                                auto it_s = std::find(m_OutputShadowPins.begin(), m_OutputShadowPins.end(), shadow_pin);
-                                if (it_s != m_OutputShadowPins.end())
+                                if (EraseMappedPin(m_OutputShadowPins, m_OutputShadowIndex, shadow_pin))
                                 {
-                                    m_OutputShadowPins.erase(it_s);
                                     shadow_pin->Unlink();
                                     delete shadow_pin;
                                 }
                             }
                         }
-                        else if (std::find(nodes.begin(), nodes.end(), linked_node) != nodes.end())
+                        else if (node_set.count(linked_node))
                         {
                             // data input pin link with inside pin
                             pin->m_Flags &= ~PIN_FLAG_EXPORTED;
@@ -705,23 +832,19 @@ struct GroupNode final : Node
                             // 5. if bridge pin linkfrom is 0, delete bridge/shadow pin
                             if (link->m_LinkFrom.size() == 0)
                             {
-                                auto it_b = std::find(m_InputBridgePins.begin(), m_InputBridgePins.end(), link);
-                                if (it_b != m_InputBridgePins.end())
+                                if (EraseMappedPin(m_InputBridgePins, m_InputBridgeIndex, link))
                                 {
-                                    m_InputBridgePins.erase(it_b);
                                     link->Unlink();
                                     delete link;
                                 }
-                                auto it_s = std::find(m_InputShadowPins.begin(), m_InputShadowPins.end(), shadow_pin);
-                                if (it_s != m_InputShadowPins.end())
+                                if (EraseMappedPin(m_InputShadowPins, m_InputShadowIndex, shadow_pin))
                                 {
-                                    m_InputShadowPins.erase(it_s);
                                     shadow_pin->Unlink();
                                     delete shadow_pin;
                                 }
                             }
                         }
-                        else if (std::find(nodes.begin(), nodes.end(), linked_node) != nodes.end())
+                        else if (node_set.count(linked_node))
                         {
                             // flow output pin link with inside pin
                             pin->m_Flags &= ~PIN_FLAG_EXPORTED;
@@ -853,22 +976,18 @@ struct GroupNode final : Node
                                 // 4. link inside pin linkfrom pin with current pin
                                 in_link->LinkTo(*pin);
                                 // 5. if shadow pin linkfrom size is 0, delete bridge/shadow pin
-                                auto it_b = std::find(m_InputBridgePins.begin(), m_InputBridgePins.end(), link);
-                                if (it_b != m_InputBridgePins.end())
+                                if (EraseMappedPin(m_InputBridgePins, m_InputBridgeIndex, link))
                                 {
-                                    m_InputBridgePins.erase(it_b);
                                     link->Unlink();
                                     delete link;
                                 }
-                                auto it_s = std::find(m_InputShadowPins.begin(), m_InputShadowPins.end(), shadow_pin);
-                                if (it_s != m_InputShadowPins.end())
+                                if (EraseMappedPin(m_InputShadowPins, m_InputShadowIndex, shadow_pin))
                                 {
-                                    m_InputShadowPins.erase(it_s);
                                     shadow_pin->Unlink();
                                     delete shadow_pin;
                                 }
                             }
-                            else if (std::find(nodes.begin(), nodes.end(), linked_node) != nodes.end())
+                            else if (node_set.count(linked_node))
                             {
                                 // data output pin link with inside pin
                                 if (link->m_Link != pin->m_ID)
@@ -975,33 +1094,31 @@ struct GroupNode final : Node
         // remove ungrouped node
         for (auto iter = m_GroupNodes.begin(); iter != m_GroupNodes.end();)
         {
-            if (std::find(nodes.begin(), nodes.end(), *iter) == nodes.end())
+            if (!node_set.count(*iter))
             {
                 auto node = *iter;
                 if (node->m_GroupID == m_ID)
                 {
                     node->m_GroupID = 0;
+                    node->MarkDirty();
                     ed::SetNodeGroupID(node->m_ID, ed::NodeId::Invalid);
                     ed::SetNodeZPosition(node->m_ID, 0);
                 }
                 iter = m_GroupNodes.erase(iter);
+                m_GroupNodeSet.erase(node);
                 for (auto pin : node->GetInputPins())
                 {
-                    auto it = std::find(m_InputMapPins.begin(), m_InputMapPins.end(), pin);
-                    if (it != m_InputMapPins.end())
+                    if (EraseMapPin(m_InputMapPins, m_InputMapPinSet, pin))
                     {
                         pin->m_Flags &= ~PIN_FLAG_EXPORTED;
-                        m_InputMapPins.erase(it);
                         RemoveInputPin(pin);
                     }
                 }
                 for (auto pin : node->GetOutputPins())
                 {
-                    auto it = std::find(m_OutputMapPins.begin(), m_OutputMapPins.end(), pin);
-                    if (it != m_OutputMapPins.end())
+                    if (EraseMapPin(m_OutputMapPins, m_OutputMapPinSet, pin))
                     {
                         pin->m_Flags &= ~PIN_FLAG_EXPORTED;
-                        m_OutputMapPins.erase(it);
                         RemoveOutputPin(pin);
                     }
                 }
@@ -1012,6 +1129,14 @@ struct GroupNode final : Node
             }
         }
 
+        for (auto& item : member_flags)
+        {
+            if (item.first->m_Flags != item.second)
+                item.first->MarkDirty();
+        }
+        // bridge and shadow pins of group itself may have changed
+        MarkDirty();
+
         ed::SetNodeZPosition(m_ID, m_ZPos); 
         // re-order Z position
         for (auto iter = m_GroupNodes.begin(); iter != m_GroupNodes.end();iter ++)
@@ -1031,30 +1156,24 @@ struct GroupNode final : Node
             // remove node pin from group
             for (auto pin : node->GetInputPins())
             {
-                auto iter = std::find(m_InputMapPins.begin(), m_InputMapPins.end(), pin);
-                if (iter != m_InputMapPins.end())
+                if (EraseMapPin(m_InputMapPins, m_InputMapPinSet, pin))
                 {
-                    Pin * pin = *iter;
-                    m_InputMapPins.erase(iter);
                     RemoveInputPin(pin, false);
                 }
             }
             for (auto pin : node->GetOutputPins())
             {
-                auto iter = std::find(m_OutputMapPins.begin(), m_OutputMapPins.end(), pin);
-                if (iter != m_OutputMapPins.end())
+                if (EraseMapPin(m_OutputMapPins, m_OutputMapPinSet, pin))
                 {
-                    Pin * pin = *iter;
-                    m_OutputMapPins.erase(iter);
                     RemoveOutputPin(pin, false);
                 }
             }
             // remove node from m_GroupNodes
-            auto iter = std::find(m_GroupNodes.begin(), m_GroupNodes.end(), node);
-            if (iter != m_GroupNodes.end())
+            if (m_GroupNodeSet.erase(node))
             {
-                m_GroupNodes.erase(iter);
+                m_GroupNodes.erase(std::find(m_GroupNodes.begin(), m_GroupNodes.end(), node));
             }
+            MarkDirty();
         }
         else
         {
@@ -1073,6 +1192,7 @@ struct GroupNode final : Node
             for (auto node : m_GroupNodes)
             {
                 node->m_GroupID = 0;
+                node->MarkDirty();
                 ed::SetNodeGroupID(node->m_ID, ed::NodeId::Invalid);
                 ed::SetNodeZPosition(node->m_ID, 0);
             }
@@ -1116,7 +1236,7 @@ struct GroupNode final : Node
             Pin* pin = nullptr;
             if (type == PinType::Custom)
             {
-                CustomPin * new_pin = new CustomPin(this, "", "");
+                CustomPin * new_pin = new (m_Blueprint) CustomPin(this, "", "");
                 if (!new_pin->Load(pinValue))
                 {
                     delete new_pin;
@@ -1126,7 +1246,7 @@ struct GroupNode final : Node
             }
             else if (type == PinType::Any)
             {
-                AnyPin * new_pin = new AnyPin(this);
+                AnyPin * new_pin = new (m_Blueprint) AnyPin(this);
                 if (!new_pin->Load(pinValue))
                 {
                     delete new_pin;
@@ -1136,7 +1256,7 @@ struct GroupNode final : Node
             }
             else
             {
-                pin = new Pin(this, type, "");
+                pin = new (m_Blueprint) Pin(this, type, "");
                 if (!pin->Load(pinValue))
                 {
                     delete pin;
@@ -1192,10 +1312,11 @@ struct GroupNode final : Node
                 return BP_ERR_INPIN_LOAD;
         }
 
+        RebuildIndex();
         return ret;
     }
 
-    void Save(imgui_json::value& value, std::map<ID_TYPE, ID_TYPE> MapID = {}) override
+    void Save(imgui_json::value& value, const std::map<ID_TYPE, ID_TYPE>& MapID = {}) override
     {
         Node::Save(value, MapID);
         auto& inputPinsValue = value["input_shadow_pins"]; // optional
@@ -1313,19 +1434,6 @@ struct GroupNode final : Node
         result.save(path_name);
     }
 
-    inline void GetPinIDMap(const imgui_json::value& pinValue, std::map<ID_TYPE, ID_TYPE>& IDMaps)
-    {
-        ID_TYPE object_id;
-        imgui_json::GetTo<imgui_json::number>(pinValue, "id", object_id);
-        IDMaps[object_id] = m_Blueprint->MakePinID(nullptr);
-        if (pinValue.contains("inner"))
-        {
-            auto innerValue = pinValue["inner"];
-            imgui_json::GetTo<imgui_json::number>(innerValue, "id", object_id);
-            IDMaps[object_id] = m_Blueprint->MakePinID(nullptr);
-        }
-    }
-
     inline void AdjestPinID(Pin * pin, std::map<ID_TYPE, ID_TYPE>& IDMaps)
     {
         pin->m_ID = GetIDFromMap(pin->m_ID, IDMaps);
@@ -1345,76 +1453,22 @@ struct GroupNode final : Node
         }
     }
 
-    void LoadGroup(const imgui_json::value& value, ImVec2 pos)
+    void LoadGroup(const GroupTemplate& tmpl, ImVec2 pos)
     {
         // rebuild ID Maps
         std::map<ID_TYPE, ID_TYPE> IDMaps;
-        auto& groupValue = value["group"];
-        auto& statusValue = value["status"];
-        ID_TYPE object_id;
-        imgui_json::GetTo<imgui_json::number>(groupValue, "id", object_id);
-        IDMaps[object_id] = m_ID;
-        const imgui_json::array* inputPinsArray = nullptr;
-        if (imgui_json::GetPtrTo(groupValue, "input_pins", inputPinsArray))
+        IDMaps[tmpl.m_ID] = m_ID;
+        for (auto id : tmpl.m_PinIDs)
+            IDMaps[id] = m_Blueprint->MakePinID(nullptr);
+        for (auto& member : tmpl.m_Members)
         {
-            for (auto& pinValue : *inputPinsArray)
-            {
-                GetPinIDMap(pinValue, IDMaps);
-            }
-        }
-        const imgui_json::array* outputPinsArray = nullptr;
-        if (imgui_json::GetPtrTo(groupValue, "output_pins", outputPinsArray))
-        {
-            for (auto& pinValue : *outputPinsArray)
-            {
-                GetPinIDMap(pinValue, IDMaps);
-            }
-        }
-        const imgui_json::array* inputShadowPinsArray = nullptr;
-        if (imgui_json::GetPtrTo(groupValue, "input_shadow_pins", inputShadowPinsArray)) // optional
-        {
-            for (auto& pinValue : *inputShadowPinsArray)
-            {
-                GetPinIDMap(pinValue, IDMaps);
-            }
-        }
-        const imgui_json::array* outputShadowPinsArray = nullptr;
-        if (imgui_json::GetPtrTo(groupValue, "output_shadow_pins", outputShadowPinsArray)) // optional
-        {
-            for (auto& pinValue : *outputShadowPinsArray)
-            {
-                GetPinIDMap(pinValue, IDMaps);
-            }
+            IDMaps[member.m_ID] = m_Blueprint->MakeNodeID(nullptr);
+            for (auto id : member.m_PinIDs)
+                IDMaps[id] = m_Blueprint->MakePinID(nullptr);
         }
 
-        const imgui_json::array* nodeArray = nullptr;
-        if (imgui_json::GetPtrTo(value, "nodes", nodeArray))
-        {
-            for (auto& nodeValue : *nodeArray)
-            {
-                imgui_json::GetTo<imgui_json::number>(nodeValue, "id", object_id);
-                IDMaps[object_id] = m_Blueprint->MakeNodeID(nullptr);
-                const imgui_json::array* nodeInputPinsArray = nullptr;
-                if (imgui_json::GetPtrTo(nodeValue, "input_pins", nodeInputPinsArray))
-                {
-                    for (auto& pinValue : *nodeInputPinsArray)
-                    {
-                        GetPinIDMap(pinValue, IDMaps);
-                    }
-                }
-                const imgui_json::array* nodeOutputPinsArray = nullptr;
-                if (imgui_json::GetPtrTo(nodeValue, "output_pins", nodeOutputPinsArray))
-                {
-                    for (auto& pinValue : *nodeOutputPinsArray)
-                    {
-                        GetPinIDMap(pinValue, IDMaps);
-                    }
-                }
-            }
-        }
         // Load Group Value
-        Load(groupValue);
-        auto GroupStatus = statusValue[edd::Serialization::ToString((const ed::NodeId)(m_ID))];
+        Load(*tmpl.m_GroupValue);
         m_ID = GetIDFromMap(m_ID, IDMaps);
         for (auto pin : m_InputBridgePins)
         {
@@ -1435,52 +1489,37 @@ struct GroupNode final : Node
         // Set group node status
         auto base_pos = ed::ScreenToCanvas(pos);
         ed::SetNodePosition(m_ID, base_pos);
-        ImVec2 group_node_size;
-        imgui_json::GetTo<imgui_json::number>(GroupStatus["size"], "x", group_node_size.x);
-        imgui_json::GetTo<imgui_json::number>(GroupStatus["size"], "y", group_node_size.y);
-        ed::SetNodeSize(m_ID, group_node_size);
-        ImVec2 group_size;
-        imgui_json::GetTo<imgui_json::number>(GroupStatus["group_size"], "x", group_size.x);
-        imgui_json::GetTo<imgui_json::number>(GroupStatus["group_size"], "y", group_size.y);
-        ed::SetGroupSize(m_ID, group_size);
+        ed::SetNodeSize(m_ID, tmpl.m_NodeSize);
+        ed::SetGroupSize(m_ID, tmpl.m_GroupSize);
 
         // Create Group In-Nodes
-        const imgui_json::array* groupNodeArray = nullptr;
-        if (imgui_json::GetPtrTo(value, "nodes", groupNodeArray))
+        m_GroupNodes.reserve(m_GroupNodes.size() + tmpl.m_Members.size());
+        for (auto& member : tmpl.m_Members)
         {
-            for (auto& nodeValue : *groupNodeArray)
+            if (!member.m_TypeID)
+                continue;
+            auto node = m_Blueprint->CreateNode(member.m_TypeID);
+            if (!node)
+                continue;
+            node->Load(*member.m_Value);
+            node->m_ID = GetIDFromMap(node->m_ID, IDMaps);
+            node->m_GroupID = GetIDFromMap(node->m_GroupID, IDMaps);
+            ed::SetNodeGroupID(node->m_ID, node->m_GroupID);
+            for (auto pin : node->GetInputPins())
             {
-                ID_TYPE typeId;
-                if (!imgui_json::GetTo<imgui_json::number>(nodeValue, "type_id", typeId))
-                    continue;
-                auto node = m_Blueprint->CreateNode(typeId);
-                if (!node)
-                    continue;
-                node->Load(nodeValue);
-                auto nodeStatus = statusValue[edd::Serialization::ToString((const ed::NodeId)(node->m_ID))];
-                node->m_ID = GetIDFromMap(node->m_ID, IDMaps);
-                node->m_GroupID = GetIDFromMap(node->m_GroupID, IDMaps);
-                ed::SetNodeGroupID(node->m_ID, node->m_GroupID);
-                for (auto pin : node->GetInputPins())
-                {
-                    AdjestPinID(pin, IDMaps);
-                }
-                for (auto pin : node->GetOutputPins())
-                {
-                    AdjestPinID(pin, IDMaps);
-                }
-                ImVec2 node_location;
-                imgui_json::GetTo<imgui_json::number>(nodeStatus["location"], "x", node_location.x);
-                imgui_json::GetTo<imgui_json::number>(nodeStatus["location"], "y", node_location.y);
-                node_location += base_pos;
-                ed::SetNodePosition(node->m_ID, node_location);
-                ImVec2 node_size;
-                imgui_json::GetTo<imgui_json::number>(nodeStatus["size"], "x", node_size.x);
-                imgui_json::GetTo<imgui_json::number>(nodeStatus["size"], "y", node_size.y);
-                ed::SetNodeSize(node->m_ID, node_size);
-                m_GroupNodes.push_back(node);
+                AdjestPinID(pin, IDMaps);
             }
+            for (auto pin : node->GetOutputPins())
+            {
+                AdjestPinID(pin, IDMaps);
+            }
+            ImVec2 node_location = member.m_Location;
+            node_location += base_pos;
+            ed::SetNodePosition(node->m_ID, node_location);
+            ed::SetNodeSize(node->m_ID, member.m_Size);
+            m_GroupNodes.push_back(node);
         }
+        RebuildIndex();
     }
 
     span<Pin*> GetInputPins() override { return m_InputBridgePins; }
@@ -1497,6 +1536,16 @@ struct GroupNode final : Node
     std::vector<Pin *> m_InputShadowPins;
     std::vector<Pin *> m_OutputShadowPins;
 
+    // lookup side of the vectors above, bridge/shadow pins are keyed by m_MappedPin
+    std::unordered_set<Node *> m_GroupNodeSet;
+    std::unordered_set<Pin *> m_InputMapPinSet;
+    std::unordered_set<Pin *> m_OutputMapPinSet;
+    std::unordered_map<ID_TYPE, Pin *> m_InputBridgeIndex;
+    std::unordered_map<ID_TYPE, Pin *> m_OutputBridgeIndex;
+    std::unordered_map<ID_TYPE, Pin *> m_InputShadowIndex;
+    std::unordered_map<ID_TYPE, Pin *> m_OutputShadowIndex;
+    uint64_t m_ScanRevision {static_cast<uint64_t>(-1)}; // BP link revision at last full scan
+
     bool m_Dragging {false};
     float m_ZPos {1.f};
     std::mutex m_mutex;
@@ -16,6 +16,8 @@ struct MatExitPointNode final : Node
         return {};
     }
 
+    Node* Clone(BP* blueprint, const std::map<ID_TYPE, ID_TYPE>& MapID = {}) override { return CloneAs<MatExitPointNode>(blueprint, MapID); }
+
     span<Pin*> GetInputPins() override { return m_InputPins; }
     Pin* GetAutoLinkInputFlowPin() override { return &m_Enter; }
     vector<Pin*> GetAutoLinkInputDataPin() override { return {&m_MatIn}; }
@@ -19,7 +19,7 @@ struct FilterEntryPointNode final : Node
 
     Pin* InsertOutputPin(PinType type, const std::string name) override
     {
-        Pin* pin = new Pin(this, type, name);
+        Pin* pin = new (m_Blueprint) Pin(this, type, name);
         pin->m_Flags |= PIN_FLAG_FORCESHOW;
         m_OutputPins.push_back(pin);
         return pin;
@@ -79,7 +79,7 @@ struct FilterEntryPointNode final : Node
                 Pin* pin = nullptr;
                 if (type == PinType::Custom)
                 {
-                    CustomPin * new_pin = new CustomPin(this, "", "");
+                    CustomPin * new_pin = new (m_Blueprint) CustomPin(this, "", "");
                     if (!new_pin->Load(pinValue))
                     {
                         delete new_pin;
@@ -89,7 +89,7 @@ struct FilterEntryPointNode final : Node
                 }
                 else if (type == PinType::Any)
                 {
-                    AnyPin * new_pin = new AnyPin(this);
+                    AnyPin * new_pin = new (m_Blueprint) AnyPin(this);
                     if (!new_pin->Load(pinValue))
                     {
                         delete new_pin;
@@ -99,7 +99,7 @@ struct FilterEntryPointNode final : Node
                 }
                 else
                 {
-                    pin = new Pin(this, type, "");
+                    pin = new (m_Blueprint) Pin(this, type, "");
                     if (!pin->Load(pinValue))
                     {
                         delete pin;
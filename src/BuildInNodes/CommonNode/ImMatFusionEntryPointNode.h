@@ -22,7 +22,7 @@ struct TransitionEntryPointNode final : Node
 
     Pin* InsertOutputPin(PinType type, const std::string name) override
     {
-        Pin* pin = new Pin(this, type, name);
+        Pin* pin = new (m_Blueprint) Pin(this, type, name);
         pin->m_Flags |= PIN_FLAG_FORCESHOW;
         m_OutputPins.push_back(pin);
         return pin;
@@ -82,7 +82,7 @@ struct TransitionEntryPointNode final : Node
                 Pin* pin = nullptr;
                 if (type == PinType::Custom)
                 {
-                    CustomPin * new_pin = new CustomPin(this, "", "");
+                    CustomPin * new_pin = new (m_Blueprint) CustomPin(this, "", "");
                     if (!new_pin->Load(pinValue))
                     {
                         delete new_pin;
@@ -92,7 +92,7 @@ struct TransitionEntryPointNode final : Node
                 }
                 else if (type == PinType::Any)
                 {
-                    AnyPin * new_pin = new AnyPin(this);
+                    AnyPin * new_pin = new (m_Blueprint) AnyPin(this);
                     if (!new_pin->Load(pinValue))
                     {
                         delete new_pin;
@@ -102,7 +102,7 @@ struct TransitionEntryPointNode final : Node
                 }
                 else
                 {
-                    pin = new Pin(this, type, "");
+                    pin = new (m_Blueprint) Pin(this, type, "");
                     if (!pin->Load(pinValue))
                     {
                         delete pin;
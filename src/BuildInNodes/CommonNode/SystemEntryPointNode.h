@@ -13,6 +13,8 @@ struct SystemEntryPointNode final : Node
         return m_Exit;
     }
 
+    Node* Clone(BP* blueprint, const std::map<ID_TYPE, ID_TYPE>& MapID = {}) override { return CloneAs<SystemEntryPointNode>(blueprint, MapID); }
+
     span<Pin*> GetOutputPins() override { return m_OutputPins; }
     FlowPin* GetOutputFlowPin() override { return &m_Exit; }
     Pin* GetAutoLinkOutputFlowPin() override { return &m_Exit; }
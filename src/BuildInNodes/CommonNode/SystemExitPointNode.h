@@ -14,6 +14,8 @@ struct SystemExitPointNode final : Node
         return {};
     }
 
+    Node* Clone(BP* blueprint, const std::map<ID_TYPE, ID_TYPE>& MapID = {}) override { return CloneAs<SystemExitPointNode>(blueprint, MapID); }
+
     span<Pin*> GetInputPins() override { return m_InputPins; }
     Pin* GetAutoLinkInputFlowPin() override { return &m_Enter; }
 
@@ -18,6 +18,8 @@ struct BranchNode final : Node
             return m_False;
     }
 
+    Node* Clone(BP* blueprint, const std::map<ID_TYPE, ID_TYPE>& MapID = {}) override { return CloneAs<BranchNode>(blueprint, MapID); }
+
     span<Pin*> GetInputPins() override { return m_InputPins; }
     span<Pin*> GetOutputPins() override { return m_OutputPins; }
 
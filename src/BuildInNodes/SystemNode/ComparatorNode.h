@@ -157,7 +157,7 @@ struct ComparatorNode final : Node
         return ret;
     }
 
-    void Save(imgui_json::value& value, std::map<ID_TYPE, ID_TYPE> MapID = {}) override
+    void Save(imgui_json::value& value, const std::map<ID_TYPE, ID_TYPE>& MapID = {}) override
     {
         Node::Save(value, MapID);
         value["datatype"] = PinTypeToString(m_Type);
@@ -175,7 +175,7 @@ struct ConstValueNode final : Node
         return ret;
     }
 
-    void Save(imgui_json::value& value, std::map<ID_TYPE, ID_TYPE> MapID = {}) override
+    void Save(imgui_json::value& value, const std::map<ID_TYPE, ID_TYPE>& MapID = {}) override
     {
         Node::Save(value, MapID);
         value["datatype"] = PinTypeToString(m_Value.GetValueType());
@@ -50,7 +50,9 @@ struct CountNode final : Node
 
         // Draw Custom Setting
         ImGui::SetCurrentContext(ctx);
-        ImGui::TextUnformatted("Accumulate"); ImGui::SameLine(0.f, 100.f); ImGui::ToggleButton("##toggle_acc", &m_Accumulate);
+        ImGui::TextUnformatted("Accumulate"); ImGui::SameLine(0.f, 100.f);
+        if (ImGui::ToggleButton("##toggle_acc", &m_Accumulate))
+            MarkDirty();
     }
 
     int Load(const imgui_json::value& value) override
@@ -70,12 +72,22 @@ struct CountNode final : Node
         return ret;
     }
 
-    void Save(imgui_json::value& value, std::map<ID_TYPE, ID_TYPE> MapID = {}) override
+    void Save(imgui_json::value& value, const std::map<ID_TYPE, ID_TYPE>& MapID = {}) override
     {
         Node::Save(value, MapID);
         value["accumulate"] = imgui_json::boolean(m_Accumulate);
     }
 
+    Node* Clone(BP* blueprint, const std::map<ID_TYPE, ID_TYPE>& MapID = {}) override { return CloneAs<CountNode>(blueprint, MapID); }
+
+    bool CopyTo(Node& node, const std::map<ID_TYPE, ID_TYPE>& MapID = {}) override
+    {
+        if (!Node::CopyTo(node, MapID))
+            return false;
+        static_cast<CountNode&>(node).m_Accumulate = m_Accumulate;
+        return true;
+    }
+
     span<Pin*> GetInputPins() override { return m_InputPins; }
     span<Pin*> GetOutputPins() override { return m_OutputPins; }
 
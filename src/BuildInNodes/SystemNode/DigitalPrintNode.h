@@ -45,7 +45,7 @@ struct PrintNode final : Node
             {
                 s_PrintFunction(*this, m_string);
             }
-            LOGD("PrintNode: %s\n", m_string.c_str()); // need disable on run thread mode
+            LOGD("PrintNode: %s\n", m_string.c_str());
         }
         return m_Exit;
     }
@@ -92,7 +92,7 @@ struct PrintNode final : Node
         return ret;
     }
 
-    void Save(imgui_json::value& value, std::map<ID_TYPE, ID_TYPE> MapID) override
+    void Save(imgui_json::value& value, const std::map<ID_TYPE, ID_TYPE>& MapID) override
     {
         Node::Save(value, MapID);
         value["layout"] = m_print_to_layout;
@@ -25,6 +25,8 @@ struct FlipFlopNode final : Node
             return m_B;
     }
 
+    Node* Clone(BP* blueprint, const std::map<ID_TYPE, ID_TYPE>& MapID = {}) override { return CloneAs<FlipFlopNode>(blueprint, MapID); }
+
     span<Pin*> GetInputPins() override { return m_InputPins; }
     span<Pin*> GetOutputPins() override { return m_OutputPins; }
 
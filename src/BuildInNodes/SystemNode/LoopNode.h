@@ -39,6 +39,8 @@ struct LoopNode final : Node
         return m_Completed;
     }
 
+    Node* Clone(BP* blueprint, const std::map<ID_TYPE, ID_TYPE>& MapID = {}) override { return CloneAs<LoopNode>(blueprint, MapID); }
+
     span<Pin*> GetInputPins() override { return m_InputPins; }
     span<Pin*> GetOutputPins() override { return m_OutputPins; }
 
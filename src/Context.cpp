@@ -88,15 +88,12 @@ StepResult Context::Step(Context * context, bool restep)
     auto next = entryPin->m_Node->Execute(*context, *entryPin, isthreading);
     auto end_time = ImGui::get_current_time_usec();
     entryPin->m_Node->m_Tick += end_time - start_time;
+    entryPin->m_Node->m_Latency.Record(end_time - start_time);
 
     if (next.m_Node)
     {
         auto bp = next.m_Node->m_Blueprint;
-        auto link = next.GetLink(bp);
-        while (link && link->IsMappedPin())
-        {
-            link = link->GetLink(bp);
-        }
+        auto link = bp->ResolveLink(next);
         if (link && link->m_Type == PinType::Flow)
         {
             g_Mutex.lock();
@@ -325,11 +322,7 @@ void Context::ShowFlow()
             if (!pin->m_Link || !pin->m_Node)
                 continue;
             auto bp = pin->m_Node->m_Blueprint;
-            auto link = pin->GetLink(bp);
-            while (link && link->IsMappedPin())
-            {
-                link = link->GetLink(bp);
-            }
+            auto link = bp->ResolveLink(*pin);
             if (!link || link->m_Node != m_CurrentNode)
                 continue;
             ed::Flow(pin->m_ID, pin->GetType() == PinType::Flow ? ed::FlowDirection::Forward : ed::FlowDirection::Backward);
@@ -349,11 +342,7 @@ void Context::ShowFlow()
             if (!pin->m_Link || !pin->m_Node)
                 continue;
             auto bp = pin->m_Node->m_Blueprint;
-            auto link = pin->GetLink(bp);
-            while (link && link->IsMappedPin())
-            {
-                link = link->GetLink(bp);
-            }
+            auto link = bp->ResolveLink(*pin);
             if (!link)
                 continue;
             
@@ -386,14 +375,20 @@ Node* Context::NextNode()
     if (m_CurrentFlowPin.m_Link)
     {
         auto bp = node->m_Blueprint;
+        const Pin* from = &m_CurrentFlowPin;
         auto link = m_CurrentFlowPin.GetLink(bp);
         while (link && !link->IsMappedPin())
         {
             node = link->m_Node;
+            from = link;
             link = link->GetLink(bp);
         }
         if (link)
-            node = link->m_Node;
+        {
+            // into a group, point at the member which runs next rather than the group
+            auto provider = bp->ResolveLink(*from);
+            node = provider ? provider->m_Node : link->m_Node;
+        }
     }
 
     g_Mutex.unlock();
@@ -407,14 +402,20 @@ const Node* Context::NextNode() const
     if (m_CurrentFlowPin.m_Link)
     {
         auto bp = node->m_Blueprint;
+        const Pin* from = &m_CurrentFlowPin;
         auto link = m_CurrentFlowPin.GetLink(bp);
         while (link && !link->IsMappedPin())
         {
             node = link->m_Node;
+            from = link;
             link = link->GetLink(bp);
         }
         if (link)
-            node = link->m_Node;
+        {
+            // into a group, point at the member which runs next rather than the group
+            auto provider = bp->ResolveLink(*from);
+            node = provider ? provider->m_Node : link->m_Node;
+        }
     }
     g_Mutex.unlock();
     return node;
@@ -456,11 +457,21 @@ PinValue Context::GetPinValue(const Pin& pin, bool threading) const
 
     PinValue value;
     auto bp = pin.m_Node->m_Blueprint;
-    auto link = pin.GetLink(bp);
+    const Pin* link = pin.GetLink(bp);
+    if (link && link->IsMappedPin())
+    {
+        // crossing group boundaries, skip bridge/shadow pins in one lookup
+        if (auto provider = bp->ResolveLink(pin))
+            link = provider;
+    }
     if (link)
         value = GetPinValue(*link);
     else if (pin.m_Node)
+    {
+        if (m_Monitor) m_Monitor->OnPreEvaluate(*this, pin);
         value = pin.m_Node->EvaluatePin(*this, pin, threading);
+        if (m_Monitor) m_Monitor->OnPostEvaluate(*this, pin);
+    }
     else
         value = pin.GetValue();
 
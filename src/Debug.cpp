@@ -6,6 +6,11 @@
 #include <imgui_canvas.h>
 #include <sstream>
 #include <iomanip>
+#include <cstdarg>
+#include <cstdlib>
+#include <chrono>
+#include <condition_variable>
+#include <unordered_map>
 
 namespace ed = ax::NodeEditor;
 DECLARE_HAS_MEMBER(HasVtxCurrentOffset, _VtxCurrentOffset);
@@ -268,4 +273,555 @@ void DebugOverlay::OnStepCurrent(Context& context)
     m_Blueprint->OnContextStepCurrent();
 }
 
-} // namespace BluePrint
\ No newline at end of file
+// ---------------------------------
+// -------[ ExecutionTracer ]-------
+// ---------------------------------
+static std::atomic<uint64_t> s_TracerSession {0};
+
+ExecutionTracer::ExecutionTracer(size_t capacity)
+    : m_Capacity(capacity > 0 ? capacity : 1)
+    , m_Session(++s_TracerSession)
+{
+}
+
+ExecutionTracer::~ExecutionTracer()
+{
+    // same as DebugOverlay, blueprint may already be released here, owner calls Detach()
+}
+
+void ExecutionTracer::Attach(BP* blueprint)
+{
+    Detach();
+    m_Blueprint = blueprint;
+    if (!m_Blueprint)
+        return;
+    m_Next = m_Blueprint->GetContextMonitor();
+    m_Blueprint->SetContextMonitor(this);
+}
+
+void ExecutionTracer::Detach()
+{
+    if (m_Blueprint && m_Blueprint->GetContextMonitor() == this)
+        m_Blueprint->SetContextMonitor(m_Next);
+    m_Blueprint = nullptr;
+    m_Next = nullptr;
+}
+
+void ExecutionTracer::Clear()
+{
+    std::lock_guard<std::mutex> lock(m_RingMutex);
+    m_Rings.clear();
+    m_Groups.clear();
+    m_Flow = 0;
+    m_Session.store(++s_TracerSession, std::memory_order_release);
+}
+
+size_t ExecutionTracer::EventCount() const
+{
+    std::lock_guard<std::mutex> lock(m_RingMutex);
+    size_t count = 0;
+    for (auto& ring : m_Rings)
+        count += (size_t)std::min<uint64_t>(ring->m_Written, m_Capacity);
+    return count;
+}
+
+ExecutionTracer::Ring* ExecutionTracer::GetRing()
+{
+    // one registration per thread, tracer and session, recording itself takes no lock.
+    // Entry is keyed by tracer, so tracers recording on same thread keep their own rings
+    // and a cleared tracer replaces its entry instead of adding one.
+    thread_local std::unordered_map<const ExecutionTracer*, std::pair<uint64_t, Ring*>> t_Rings;
+    auto session = m_Session.load(std::memory_order_acquire);
+    auto& entry = t_Rings[this];
+    if (entry.first == session && entry.second)
+        return entry.second;
+
+    std::lock_guard<std::mutex> lock(m_RingMutex);
+    auto ring = std::make_unique<Ring>();
+    ring->m_Events.resize(m_Capacity);
+    ring->m_Thread = (int)m_Rings.size() + 1;
+    entry = { m_Session.load(std::memory_order_relaxed), ring.get() };
+    m_Rings.push_back(std::move(ring));
+    return entry.second;
+}
+
+void ExecutionTracer::Record(EventType type, ID_TYPE id, ID_TYPE flow)
+{
+    auto ring = GetRing();
+    auto& event = ring->m_Events[ring->m_Written % m_Capacity];
+    event.m_Time = ImGui::get_current_time_usec();
+    event.m_ID = id;
+    event.m_Flow = flow;
+    event.m_Type = type;
+    ring->m_Written++;
+}
+
+void ExecutionTracer::EnterGroups(const Node* node)
+{
+    std::vector<ID_TYPE> groups;
+    auto bp = node->m_Blueprint;
+    for (auto group_id = node->m_GroupID; group_id && bp && groups.size() < 64;)
+    {
+        groups.push_back(group_id);
+        auto group = bp->FindNode(group_id);
+        group_id = group ? group->m_GroupID : 0;
+    }
+    std::reverse(groups.begin(), groups.end());
+
+    size_t keep = 0;
+    while (keep < groups.size() && keep < m_Groups.size() && groups[keep] == m_Groups[keep])
+        keep++;
+    LeaveGroups(keep);
+    for (size_t i = keep; i < groups.size(); i++)
+    {
+        Record(EventType::GroupBegin, groups[i]);
+        m_Groups.push_back(groups[i]);
+    }
+}
+
+void ExecutionTracer::LeaveGroups(size_t keep)
+{
+    while (m_Groups.size() > keep)
+    {
+        Record(EventType::GroupEnd, m_Groups.back());
+        m_Groups.pop_back();
+    }
+}
+
+void ExecutionTracer::OnStart(Context& context)
+{
+    m_Groups.clear();
+    m_Flow = 0;
+    if (m_Next) m_Next->OnStart(context);
+}
+
+void ExecutionTracer::OnError(Context& context)
+{
+    LeaveGroups(0);
+    m_Flow = 0;
+    if (m_Next) m_Next->OnError(context);
+}
+
+void ExecutionTracer::OnDone(Context& context)
+{
+    LeaveGroups(0);
+    m_Flow = 0;
+    if (m_Next) m_Next->OnDone(context);
+}
+
+void ExecutionTracer::OnPause(Context& context)
+{
+    if (m_Next) m_Next->OnPause(context);
+}
+
+void ExecutionTracer::OnResume(Context& context)
+{
+    if (m_Next) m_Next->OnResume(context);
+}
+
+void ExecutionTracer::OnStepNext(Context& context)
+{
+    if (m_Next) m_Next->OnStepNext(context);
+}
+
+void ExecutionTracer::OnStepCurrent(Context& context)
+{
+    if (m_Next) m_Next->OnStepCurrent(context);
+}
+
+void ExecutionTracer::OnPreStep(Context& context)
+{
+    if (auto node = context.m_CurrentNode)
+    {
+        EnterGroups(node);
+        Record(EventType::NodeBegin, node->m_ID);
+        if (m_Flow)
+            Record(EventType::FlowIn, context.m_PrevFlowPin.m_ID, m_Flow);
+        m_Flow = 0;
+        m_Stepping = true;
+    }
+    if (m_Next) m_Next->OnPreStep(context);
+}
+
+void ExecutionTracer::OnPostStep(Context& context)
+{
+    if (auto node = context.m_CurrentNode)
+    {
+        m_Stepping = false;
+        if (context.m_CurrentFlowPin.m_ID)
+        {
+            m_Flow = m_NextFlow++;
+            Record(EventType::FlowOut, context.m_CurrentFlowPin.m_ID, m_Flow);
+        }
+        Record(EventType::NodeEnd, node->m_ID);
+    }
+    if (m_Next) m_Next->OnPostStep(context);
+}
+
+void ExecutionTracer::OnPreEvaluate(const Context& context, const Pin& pin)
+{
+    // flow pins are evaluated by Step() itself, between node slices
+    if (m_Stepping && pin.GetType() != PinType::Flow)
+        Record(EventType::EvalBegin, pin.m_ID);
+    if (m_Next) m_Next->OnPreEvaluate(context, pin);
+}
+
+void ExecutionTracer::OnPostEvaluate(const Context& context, const Pin& pin)
+{
+    if (m_Stepping && pin.GetType() != PinType::Flow)
+        Record(EventType::EvalEnd, pin.m_ID);
+    if (m_Next) m_Next->OnPostEvaluate(context, pin);
+}
+
+bool ExecutionTracer::Write(std::string path, const BP* blueprint) const
+{
+    auto file = fopen(path.c_str(), "wb");
+    if (!file)
+        return false;
+
+    if (!blueprint)
+        blueprint = m_Blueprint;
+    auto node_name = [blueprint](ID_TYPE id) -> std::string
+    {
+        auto node = blueprint ? blueprint->FindNode(id) : nullptr;
+        return node ? node->m_Name : "Node " + std::to_string(id);
+    };
+    auto pin_name = [blueprint](ID_TYPE id) -> std::string
+    {
+        auto pin = blueprint ? blueprint->FindPin(id) : nullptr;
+        if (!pin)
+            return "Pin " + std::to_string(id);
+        return (pin->m_Node ? pin->m_Node->m_Name + "." : std::string()) + pin->m_Name;
+    };
+
+    bool ret;
+    {
+        std::lock_guard<std::mutex> lock(m_RingMutex);
+        JsonWriter writer(file, -1);
+        writer.BeginObject();
+        writer.Key("displayTimeUnit"); writer.String("ms");
+        writer.Key("traceEvents");
+        writer.BeginArray();
+        for (auto& ring : m_Rings)
+        {
+            writer.BeginObject();
+            writer.Key("name"); writer.String("thread_name");
+            writer.Key("ph"); writer.String("M");
+            writer.Key("pid"); writer.Number(1);
+            writer.Key("tid"); writer.Number(ring->m_Thread);
+            writer.Key("args");
+            writer.BeginObject();
+            writer.Key("name"); writer.String("Blueprint thread " + std::to_string(ring->m_Thread));
+            writer.EndObject();
+            writer.EndObject();
+
+            // Ring keeps newest events, nesting of what is left is intact. Begin and end are
+            // paired into one complete event, an end whose begin was overwritten is dropped,
+            // so are begins of slices which are still open.
+            std::vector<const Event*> open;
+            uint64_t begin = ring->m_Written > m_Capacity ? ring->m_Written - m_Capacity : 0;
+            for (uint64_t i = begin; i < ring->m_Written; i++)
+            {
+                auto& event = ring->m_Events[i % m_Capacity];
+                const Event* slice = nullptr;
+                const char* phase = "X";
+                const char* category = "node";
+                std::string name;
+                switch (event.m_Type)
+                {
+                    case EventType::NodeBegin:
+                    case EventType::GroupBegin:
+                    case EventType::EvalBegin:
+                        open.push_back(&event);
+                        continue;
+                    case EventType::NodeEnd:
+                    case EventType::GroupEnd:
+                    case EventType::EvalEnd:
+                        if (open.empty())
+                            continue;
+                        slice = open.back();
+                        open.pop_back();
+                        if ((int)slice->m_Type + 1 != (int)event.m_Type)
+                            continue;
+                        if (event.m_Type == EventType::GroupEnd)
+                        {
+                            category = "group";
+                            name = node_name(slice->m_ID);
+                        }
+                        else if (event.m_Type == EventType::EvalEnd)
+                        {
+                            category = "eval";
+                            name = pin_name(slice->m_ID);
+                        }
+                        else
+                            name = node_name(slice->m_ID);
+                        break;
+                    case EventType::FlowOut:    phase = "s"; category = "flow"; name = "Flow"; break;
+                    case EventType::FlowIn:     phase = "f"; category = "flow"; name = "Flow"; break;
+                }
+                writer.BeginObject();
+                writer.Key("name"); writer.String(name);
+                writer.Key("cat"); writer.String(category);
+                writer.Key("ph"); writer.String(phase);
+                writer.Key("ts"); writer.Number((double)(slice ? slice->m_Time : event.m_Time));
+                if (slice)
+                {
+                    writer.Key("dur"); writer.Number((double)(event.m_Time - slice->m_Time));
+                }
+                writer.Key("pid"); writer.Number(1);
+                writer.Key("tid"); writer.Number(ring->m_Thread);
+                if (event.m_Type == EventType::FlowOut || event.m_Type == EventType::FlowIn)
+                {
+                    writer.Key("id"); writer.Number(event.m_Flow);
+                    if (event.m_Type == EventType::FlowIn)
+                    {
+                        writer.Key("bp"); writer.String("e");
+                    }
+                    writer.Key("args");
+                    writer.BeginObject();
+                    writer.Key("pin"); writer.String(pin_name(event.m_ID));
+                    writer.EndObject();
+                }
+                writer.EndObject();
+            }
+        }
+        writer.EndArray();
+        writer.EndObject();
+        ret = writer.Flush();
+    }
+    fclose(file);
+    return ret;
+}
+
+// ---------------------------------
+// -----------[ Logger ]------------
+// ---------------------------------
+std::atomic<int32_t> Logger::s_Level {static_cast<int32_t>(LogLevel::Warning)};
+
+// Bounded MPSC ring (Vyukov). Producer claims a slot by moving m_Head, formats into it and
+// publishes it through slot sequence. Writer thread takes published slots in order.
+struct LogWriter
+{
+    struct Slot
+    {
+        std::atomic<uint64_t>   m_Sequence {0};
+        LogLevel                m_Level {LogLevel::Info};
+        int64_t                 m_Time {0};
+        char                    m_Text[Logger::MESSAGE_SIZE];
+    };
+
+    // never deleted, LOG from static destructors running after ours must still find a writer
+    static LogWriter& Get()
+    {
+        static LogWriter* writer = new LogWriter();
+        return *writer;
+    }
+
+    LogWriter()
+        : m_Slots(new Slot[Logger::RING_SIZE])
+        , m_StartTime(ImGui::get_current_time_usec())
+    {
+        for (uint64_t i = 0; i < Logger::RING_SIZE; i++)
+            m_Slots[i].m_Sequence.store(i, std::memory_order_relaxed);
+        m_Thread = std::thread(&LogWriter::Run, this);
+        std::atexit([]() { Get().Shutdown(); });
+    }
+
+    // at exit writer thread is stopped and pending messages are written, later ones are written
+    // by Push itself
+    void Shutdown()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_WakeMutex);
+            m_Stop = true;
+        }
+        m_Wake.notify_one();
+        if (m_Thread.joinable())
+            m_Thread.join();
+        Drain();
+    }
+
+    void Push(LogLevel level, const char* format, va_list args)
+    {
+        uint64_t pos = m_Head.load(std::memory_order_relaxed);
+        Slot* slot = nullptr;
+        for (;;)
+        {
+            slot = &m_Slots[pos & (Logger::RING_SIZE - 1)];
+            auto diff = (int64_t)slot->m_Sequence.load(std::memory_order_acquire) - (int64_t)pos;
+            if (diff == 0)
+            {
+                if (m_Head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    break;
+            }
+            else if (diff < 0)
+            {
+                // writer is behind a whole ring, don't wait for it
+                m_Dropped.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+            else
+                pos = m_Head.load(std::memory_order_relaxed);
+        }
+        slot->m_Level = level;
+        slot->m_Time = ImGui::get_current_time_usec();
+        vsnprintf(slot->m_Text, sizeof(slot->m_Text), format, args);
+        slot->m_Sequence.store(pos + 1, std::memory_order_release);
+        if (m_Stop.load(std::memory_order_acquire))
+        {
+            Drain();
+            return;
+        }
+        // pairs with fence in Run(), either writer sees this message or we see it sleeping
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (m_Sleeping.load(std::memory_order_relaxed))
+            m_Wake.notify_one();
+    }
+
+    // writes every published message, returns position of first one not written yet
+    uint64_t Drain()
+    {
+        std::lock_guard<std::mutex> lock(m_OutputMutex);
+        bool written = false;
+        for (;; m_Tail++)
+        {
+            auto& slot = m_Slots[m_Tail & (Logger::RING_SIZE - 1)];
+            if (slot.m_Sequence.load(std::memory_order_acquire) != m_Tail + 1)
+                break;
+            Output(slot);
+            slot.m_Sequence.store(m_Tail + Logger::RING_SIZE, std::memory_order_release);
+            written = true;
+        }
+        if (written)
+        {
+            if (m_Console) fflush(stderr);
+            if (m_File) fflush(m_File);
+        }
+        return m_Tail;
+    }
+
+    void Flush()
+    {
+        auto head = m_Head.load(std::memory_order_acquire);
+        // slots claimed before this call may still be formatted by their thread
+        while (Drain() < head)
+            std::this_thread::yield();
+    }
+
+    bool SetFile(const std::string& path)
+    {
+        std::lock_guard<std::mutex> lock(m_OutputMutex);
+        if (m_File)
+        {
+            fclose(m_File);
+            m_File = nullptr;
+        }
+        if (path.empty())
+            return true;
+        m_File = fopen(path.c_str(), "a");
+        return m_File != nullptr;
+    }
+
+    void SetConsole(bool enable)
+    {
+        std::lock_guard<std::mutex> lock(m_OutputMutex);
+        m_Console = enable;
+    }
+
+    size_t DroppedCount() const
+    {
+        return m_Dropped.load(std::memory_order_relaxed);
+    }
+
+private:
+    // producers notify without lock, a notify sent just before wait starts is lost and timeout
+    // picks the message up instead
+    void Run()
+    {
+        while (!m_Stop)
+        {
+            Drain();
+            std::unique_lock<std::mutex> lock(m_WakeMutex);
+            m_Sleeping.store(true, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (!m_Stop && !HasPending())
+                m_Wake.wait_for(lock, std::chrono::milliseconds(100));
+            m_Sleeping.store(false, std::memory_order_relaxed);
+        }
+    }
+
+    bool HasPending()
+    {
+        std::lock_guard<std::mutex> lock(m_OutputMutex);
+        return m_Slots[m_Tail & (Logger::RING_SIZE - 1)].m_Sequence.load(std::memory_order_acquire) == m_Tail + 1;
+    }
+
+    void Output(const Slot& slot)
+    {
+        static const char levels[] = "VIDWE";
+        auto level = static_cast<size_t>(slot.m_Level);
+        auto length = strnlen(slot.m_Text, sizeof(slot.m_Text));
+        while (length > 0 && slot.m_Text[length - 1] == '\n')
+            length--;
+        auto time = (double)(slot.m_Time - m_StartTime) / 1000000.0;
+        auto tag = level < sizeof(levels) - 1 ? levels[level] : '?';
+        if (m_Console)
+            fprintf(stderr, "[%12.6f] [%c] %.*s\n", time, tag, (int)length, slot.m_Text);
+        if (m_File)
+            fprintf(m_File, "[%12.6f] [%c] %.*s\n", time, tag, (int)length, slot.m_Text);
+    }
+
+    std::unique_ptr<Slot[]>     m_Slots;
+    std::atomic<uint64_t>       m_Head {0};
+    uint64_t                    m_Tail {0};             // guarded by m_OutputMutex
+    std::atomic<size_t>         m_Dropped {0};
+    int64_t                     m_StartTime {0};
+    std::mutex                  m_OutputMutex;
+    bool                        m_Console {true};
+    FILE*                       m_File {nullptr};
+    std::atomic<bool>           m_Stop {false};
+    std::atomic<bool>           m_Sleeping {false};     // writer is about to wait or waits on m_Wake
+    std::mutex                  m_WakeMutex;
+    std::condition_variable     m_Wake;
+    std::thread                 m_Thread;
+};
+
+void Logger::SetLevel(LogLevel level)
+{
+    s_Level.store(static_cast<int32_t>(level), std::memory_order_relaxed);
+}
+
+LogLevel Logger::GetLevel()
+{
+    return static_cast<LogLevel>(s_Level.load(std::memory_order_relaxed));
+}
+
+void Logger::SetConsole(bool enable)
+{
+    LogWriter::Get().SetConsole(enable);
+}
+
+bool Logger::SetFile(std::string path)
+{
+    return LogWriter::Get().SetFile(path);
+}
+
+void Logger::Flush()
+{
+    LogWriter::Get().Flush();
+}
+
+size_t Logger::DroppedCount()
+{
+    return LogWriter::Get().DroppedCount();
+}
+
+void Logger::Write(LogLevel level, const char* format, ...)
+{
+    va_list args;
+    va_start(args, format);
+    LogWriter::Get().Push(level, format, args);
+    va_end(args);
+}
+
+} // namespace BluePrint
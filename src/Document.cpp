@@ -1,6 +1,18 @@
 #include <Document.h>
 #include <Utils.h>
 #include <Debug.h>
+#include <imgui_node_editor_internal.h>
+#include <algorithm>
+#include <filesystem>
+#include <unordered_map>
+#include <unordered_set>
+#include <atomic>
+#if !defined(_WIN32)
+#include <unistd.h>
+#include <sys/stat.h>
+#else
+#include <process.h>
+#endif
 
 namespace BluePrint
 {
@@ -36,6 +48,427 @@ static string SaveReasonFlagsToString(ed::SaveReasonFlags flags, std::string sep
         return string(builder.c_str(), builder.size() - separator.size());
 }
 
+// Undo steps keep structural patch between document states instead of whole state:
+//   { "v": value }                               replace value
+//   { "o": { key: patch }, "d": [ key ] }        patch or add object members, remove members
+//   { "e": [ [ index, patch ] ] }                patch array elements in place
+//   { "s": start, "r": count, "i": [ value ] }   replace count elements from start of array
+//   { "k": [ [ id, patch ] ], "x": [ id ],      patch and remove elements of array of objects with "id",
+//     "a": [ [ prev, value ] ] }                 then insert values after element prev, null prev is front
+// Nodes and pins are matched by ID, so steps still apply when other elements moved meanwhile.
+namespace edd = ax::NodeEditor::Detail;
+
+static bool EqualValue(const imgui_json::value& a, const imgui_json::value& b)
+{
+    if (a.is_object() && b.is_object())
+    {
+        auto& objectA = a.get<imgui_json::object>();
+        auto& objectB = b.get<imgui_json::object>();
+        if (objectA.size() != objectB.size())
+            return false;
+        for (auto itA = objectA.begin(), itB = objectB.begin(); itA != objectA.end(); ++itA, ++itB)
+        {
+            if (itA->first != itB->first || !EqualValue(itA->second, itB->second))
+                return false;
+        }
+        return true;
+    }
+    else if (a.is_array() && b.is_array())
+    {
+        auto& arrayA = a.get<imgui_json::array>();
+        auto& arrayB = b.get<imgui_json::array>();
+        if (arrayA.size() != arrayB.size())
+            return false;
+        for (size_t i = 0; i < arrayA.size(); i++)
+        {
+            if (!EqualValue(arrayA[i], arrayB[i]))
+                return false;
+        }
+        return true;
+    }
+    else if (a.is_string() && b.is_string())
+        return a.get<imgui_json::string>() == b.get<imgui_json::string>();
+    else if (a.is_number() && b.is_number())
+        return a.get<imgui_json::number>() == b.get<imgui_json::number>();
+    else if (a.is_boolean() && b.is_boolean())
+        return a.get<imgui_json::boolean>() == b.get<imgui_json::boolean>();
+    return a.is_null() && b.is_null();
+}
+
+static bool DiffValue(const imgui_json::value& from, const imgui_json::value& to, imgui_json::value& patch);
+
+static bool GetElementID(const imgui_json::value& element, ID_TYPE& id)
+{
+    if (!element.is_object() || !element.contains("id") || !element["id"].is_number())
+        return false;
+    id = (ID_TYPE)element["id"].get<imgui_json::number>();
+    return true;
+}
+
+// index of elements by "id", false if any element has no ID or ID is repeated
+static bool IndexElements(const imgui_json::array& array, std::unordered_map<ID_TYPE, size_t>& index)
+{
+    index.reserve(array.size());
+    for (size_t i = 0; i < array.size(); i++)
+    {
+        ID_TYPE id;
+        if (!GetElementID(array[i], id) || !index.emplace(id, i).second)
+            return false;
+    }
+    return true;
+}
+
+static imgui_json::value PrevElementID(const imgui_json::array& array, size_t index)
+{
+    ID_TYPE id;
+    if (index == 0 || !GetElementID(array[index - 1], id))
+        return imgui_json::value();
+    return imgui_json::number(id);
+}
+
+// keyed patch of arrays of objects with ID, false if arrays have no IDs or kept elements are reordered
+static bool DiffElements(const imgui_json::array& fromArray, const imgui_json::array& toArray, imgui_json::value& patch)
+{
+    std::unordered_map<ID_TYPE, size_t> fromIndex, toIndex;
+    if (!IndexElements(fromArray, fromIndex) || !IndexElements(toArray, toIndex))
+        return false;
+
+    imgui_json::value changed, removed, added;
+    size_t last = 0;
+    for (size_t i = 0; i < toArray.size(); i++)
+    {
+        ID_TYPE id;
+        GetElementID(toArray[i], id);
+        auto it = fromIndex.find(id);
+        if (it == fromIndex.end())
+        {
+            imgui_json::value entry;
+            entry.push_back(PrevElementID(toArray, i));
+            entry.push_back(toArray[i]);
+            added.push_back(std::move(entry));
+            continue;
+        }
+        if (it->second < last)
+            return false;
+        last = it->second;
+        imgui_json::value element;
+        if (!DiffValue(fromArray[it->second], toArray[i], element))
+            continue;
+        imgui_json::value entry;
+        entry.push_back(imgui_json::number(id));
+        entry.push_back(std::move(element));
+        changed.push_back(std::move(entry));
+    }
+    for (auto& item : fromIndex)
+    {
+        if (toIndex.find(item.first) == toIndex.end())
+            removed.push_back(imgui_json::number(item.first));
+    }
+    if (!changed.is_null()) patch["k"] = std::move(changed);
+    if (!removed.is_null()) patch["x"] = std::move(removed);
+    if (!added.is_null())   patch["a"] = std::move(added);
+    return true;
+}
+
+// patch turns from into to, return false if values are equal
+static bool DiffValue(const imgui_json::value& from, const imgui_json::value& to, imgui_json::value& patch)
+{
+    if (from.is_object() && to.is_object())
+    {
+        auto& fromObject = from.get<imgui_json::object>();
+        auto& toObject = to.get<imgui_json::object>();
+        imgui_json::value members;
+        imgui_json::value removed;
+        for (auto& item : toObject)
+        {
+            auto it = fromObject.find(item.first);
+            if (it == fromObject.end())
+            {
+                members[item.first]["v"] = item.second;
+                continue;
+            }
+            imgui_json::value member;
+            if (DiffValue(it->second, item.second, member))
+                members[item.first] = std::move(member);
+        }
+        for (auto& item : fromObject)
+        {
+            if (toObject.find(item.first) == toObject.end())
+                removed.push_back(imgui_json::value(item.first));
+        }
+        if (members.is_null() && removed.is_null())
+            return false;
+        if (!members.is_null()) patch["o"] = std::move(members);
+        if (!removed.is_null()) patch["d"] = std::move(removed);
+        return true;
+    }
+
+    if (from.is_array() && to.is_array())
+    {
+        auto& fromArray = from.get<imgui_json::array>();
+        auto& toArray = to.get<imgui_json::array>();
+        if (DiffElements(fromArray, toArray, patch))
+            return !patch.is_null();
+        patch = imgui_json::value();
+        if (fromArray.size() == toArray.size())
+        {
+            imgui_json::value elements;
+            for (size_t i = 0; i < toArray.size(); i++)
+            {
+                imgui_json::value element;
+                if (!DiffValue(fromArray[i], toArray[i], element))
+                    continue;
+                imgui_json::value entry;
+                entry.push_back(imgui_json::number(i));
+                entry.push_back(std::move(element));
+                elements.push_back(std::move(entry));
+            }
+            if (elements.is_null())
+                return false;
+            patch["e"] = std::move(elements);
+            return true;
+        }
+
+        // nodes are added or removed, keep equal head and tail
+        size_t count = std::min(fromArray.size(), toArray.size());
+        size_t head = 0, tail = 0;
+        while (head < count && EqualValue(fromArray[head], toArray[head]))
+            head++;
+        while (tail < count - head && EqualValue(fromArray[fromArray.size() - 1 - tail], toArray[toArray.size() - 1 - tail]))
+            tail++;
+        imgui_json::value inserted = imgui_json::array();
+        for (size_t i = head; i < toArray.size() - tail; i++)
+            inserted.push_back(toArray[i]);
+        patch["s"] = imgui_json::number(head);
+        patch["r"] = imgui_json::number(fromArray.size() - head - tail);
+        patch["i"] = std::move(inserted);
+        return true;
+    }
+
+    if (EqualValue(from, to))
+        return false;
+    patch["v"] = to;
+    return true;
+}
+
+// apply patch in place, inverse turns patched value back. Return false if patch does not fit value,
+// value is left partially patched then.
+static bool PatchValue(imgui_json::value& value, const imgui_json::value& patch, imgui_json::value& inverse)
+{
+    if (patch.contains("v"))
+    {
+        inverse["v"] = std::move(value);
+        value = patch["v"];
+    }
+    else if (patch.contains("o") || patch.contains("d"))
+    {
+        if (!value.is_object())
+            return false;
+        auto& object = value.get<imgui_json::object>();
+        if (patch.contains("o"))
+        {
+            for (auto& item : patch["o"].get<imgui_json::object>())
+            {
+                auto it = object.find(item.first);
+                if (it == object.end())
+                {
+                    // only whole value can be added
+                    if (!item.second.contains("v"))
+                        return false;
+                    object[item.first] = item.second["v"];
+                    inverse["d"].push_back(imgui_json::value(item.first));
+                }
+                else if (!PatchValue(it->second, item.second, inverse["o"][item.first]))
+                    return false;
+            }
+        }
+        if (patch.contains("d"))
+        {
+            for (auto& key : patch["d"].get<imgui_json::array>())
+            {
+                auto it = object.find(key.get<imgui_json::string>());
+                if (it == object.end())
+                    return false;
+                inverse["o"][it->first]["v"] = std::move(it->second);
+                object.erase(it);
+            }
+        }
+    }
+    else if (patch.contains("k") || patch.contains("x") || patch.contains("a"))
+    {
+        if (!value.is_array())
+            return false;
+        auto& array = value.get<imgui_json::array>();
+        std::unordered_map<ID_TYPE, size_t> index;
+        if (!IndexElements(array, index))
+            return false;
+        if (patch.contains("k"))
+        {
+            for (auto& entry : patch["k"].get<imgui_json::array>())
+            {
+                auto& element = entry.get<imgui_json::array>();
+                auto id = (ID_TYPE)element[0].get<imgui_json::number>();
+                auto it = index.find(id);
+                if (it == index.end())
+                    return false;
+                imgui_json::value elementInverse;
+                if (!PatchValue(array[it->second], element[1], elementInverse))
+                    return false;
+                imgui_json::value inverseEntry;
+                inverseEntry.push_back(imgui_json::number(id));
+                inverseEntry.push_back(std::move(elementInverse));
+                inverse["k"].push_back(std::move(inverseEntry));
+            }
+        }
+        if (patch.contains("x"))
+        {
+            // removed elements go back in array order, each after the element which was in front of it
+            std::unordered_set<ID_TYPE> removed;
+            for (auto& id : patch["x"].get<imgui_json::array>())
+            {
+                if (index.find((ID_TYPE)id.get<imgui_json::number>()) == index.end())
+                    return false;
+                removed.insert((ID_TYPE)id.get<imgui_json::number>());
+            }
+            imgui_json::array kept;
+            kept.reserve(array.size() - removed.size());
+            imgui_json::value prev;
+            for (size_t i = 0; i < array.size(); i++)
+            {
+                ID_TYPE id;
+                GetElementID(array[i], id);
+                if (removed.find(id) == removed.end())
+                    kept.push_back(std::move(array[i]));
+                else
+                {
+                    imgui_json::value inverseEntry;
+                    inverseEntry.push_back(prev);
+                    inverseEntry.push_back(std::move(array[i]));
+                    inverse["a"].push_back(std::move(inverseEntry));
+                }
+                prev = imgui_json::number(id);
+            }
+            array = std::move(kept);
+        }
+        if (patch.contains("a"))
+        {
+            for (auto& entry : patch["a"].get<imgui_json::array>())
+            {
+                auto& element = entry.get<imgui_json::array>();
+                ID_TYPE id;
+                if (!GetElementID(element[1], id))
+                    return false;
+                bool exists = std::any_of(array.begin(), array.end(), [id](const imgui_json::value& item)
+                {
+                    ID_TYPE itemID;
+                    return GetElementID(item, itemID) && itemID == id;
+                });
+                if (exists)
+                    return false;
+                size_t position = 0;
+                if (!element[0].is_null())
+                {
+                    auto prev = (ID_TYPE)element[0].get<imgui_json::number>();
+                    auto it = std::find_if(array.begin(), array.end(), [prev](const imgui_json::value& item)
+                    {
+                        ID_TYPE itemID;
+                        return GetElementID(item, itemID) && itemID == prev;
+                    });
+                    if (it == array.end())
+                        return false;
+                    position = it - array.begin() + 1;
+                }
+                array.insert(array.begin() + position, element[1]);
+                inverse["x"].push_back(imgui_json::number(id));
+            }
+        }
+    }
+    else if (patch.contains("e"))
+    {
+        if (!value.is_array())
+            return false;
+        auto& array = value.get<imgui_json::array>();
+        for (auto& entry : patch["e"].get<imgui_json::array>())
+        {
+            auto& element = entry.get<imgui_json::array>();
+            auto index = (size_t)element[0].get<imgui_json::number>();
+            if (index >= array.size())
+                return false;
+            imgui_json::value elementInverse;
+            if (!PatchValue(array[index], element[1], elementInverse))
+                return false;
+            imgui_json::value inverseEntry;
+            inverseEntry.push_back(imgui_json::number(index));
+            inverseEntry.push_back(std::move(elementInverse));
+            inverse["e"].push_back(std::move(inverseEntry));
+        }
+    }
+    else if (patch.contains("s"))
+    {
+        if (!value.is_array())
+            return false;
+        auto& array = value.get<imgui_json::array>();
+        auto& inserted = patch["i"].get<imgui_json::array>();
+        auto start = (size_t)patch["s"].get<imgui_json::number>();
+        auto count = (size_t)patch["r"].get<imgui_json::number>();
+        if (start > array.size() || count > array.size() - start)
+            return false;
+        imgui_json::value removed = imgui_json::array();
+        for (size_t i = start; i < start + count; i++)
+            removed.push_back(std::move(array[i]));
+        array.erase(array.begin() + start, array.begin() + start + count);
+        array.insert(array.begin() + start, inserted.begin(), inserted.end());
+        inverse["s"] = imgui_json::number(start);
+        inverse["r"] = imgui_json::number(inserted.size());
+        inverse["i"] = std::move(removed);
+    }
+    return true;
+}
+
+// approximate heap usage of json value
+static size_t ValueSize(const imgui_json::value& value)
+{
+    size_t size = sizeof(imgui_json::value);
+    if (value.is_string())
+        size += value.get<imgui_json::string>().size();
+    else if (value.is_array())
+    {
+        for (auto& item : value.get<imgui_json::array>())
+            size += ValueSize(item);
+    }
+    else if (value.is_object())
+    {
+        for (auto& item : value.get<imgui_json::object>())
+            size += sizeof(item) + item.first.size() + ValueSize(item.second);
+    }
+    return size;
+}
+
+static bool DiffState(const Document::DocumentState& from, const Document::DocumentState& to, imgui_json::value& delta)
+{
+    imgui_json::value patch;
+    if (DiffValue(from.m_NodesState, to.m_NodesState, patch))
+        delta["nodes"] = std::move(patch);
+    // selection is small, it is replaced as whole instead of by positions of selected objects
+    if (!EqualValue(from.m_SelectionState, to.m_SelectionState))
+        delta["selection"]["v"] = to.m_SelectionState;
+    patch = imgui_json::value();
+    if (DiffValue(from.m_BlueprintState, to.m_BlueprintState, patch))
+        delta["blueprint"] = std::move(patch);
+    return !delta.is_null();
+}
+
+static bool PatchState(Document::DocumentState& state, const imgui_json::value& delta, imgui_json::value& inverse)
+{
+    if (delta.contains("nodes") && !PatchValue(state.m_NodesState, delta["nodes"], inverse["nodes"]))
+        return false;
+    if (delta.contains("selection") && !PatchValue(state.m_SelectionState, delta["selection"], inverse["selection"]))
+        return false;
+    if (delta.contains("blueprint") && !PatchValue(state.m_BlueprintState, delta["blueprint"], inverse["blueprint"]))
+        return false;
+    return true;
+}
+
 imgui_json::value Document::DocumentState::Serialize() const
 {
     imgui_json::value result;
@@ -102,8 +535,6 @@ void Document::UndoTransaction::Begin(std::string name /*= ""*/)
 
     m_HasBegan = true;
 
-    m_State.m_State = m_Document->m_DocumentState;
-
     if (!name.empty())
         AddAction(name);
 }
@@ -170,16 +601,13 @@ void Document::UndoTransaction::Commit(std::string name)
                 LOGV("[Action] : %" PRI_sv, FMT_sv(name));
             }
 
-            m_State.m_Name = name;
-
-            if (need_undo)
-            {
-                //LOGV("[UndoTransaction] Commit: %" PRI_sv, FMT_sv(name));
-                m_Document->m_Undo.emplace_back(std::move(m_State));
-                m_Document->m_Redo.clear();
-            }
-
-            m_Document->m_DocumentState = m_Document->BuildDocumentState();
+            //LOGV("[UndoTransaction] Commit: %" PRI_sv, FMT_sv(name));
+            UndoState undoState;
+            undoState.m_Name = name;
+            if (m_Document->UpdateDocumentState(need_undo ? &undoState.m_Delta : nullptr))
+                m_Document->m_StateRevision++;
+            if (need_undo && !undoState.m_Delta.is_null())
+                m_Document->PushUndo(std::move(undoState));
         }
 
         m_Document->m_MasterTransaction = nullptr;
@@ -210,6 +638,7 @@ void Document::OnSaveBegin()
 
 bool Document::OnSaveNodeState(ID_TYPE nodeId, const imgui_json::value& value, ed::SaveReasonFlags reason)
 {
+    m_ChangedNodeStates.insert(nodeId);
     if (reason != ed::SaveReasonFlags::Size)
     {
         auto node = m_Blueprint.FindNode(nodeId);
@@ -227,7 +656,7 @@ bool Document::OnSaveState(const imgui_json::value& value, ed::SaveReasonFlags r
 {
     if ((reason & ed::SaveReasonFlags::Selection) == ed::SaveReasonFlags::Selection)
     {
-        m_DocumentState.m_SelectionState = ed::GetState(ed::StateType::Selection);
+        m_SelectionChanged = true;
         m_SaveTransaction->AddAction("Selection Changed");
     }
 
@@ -243,7 +672,9 @@ void Document::OnSaveEnd()
 {
     m_SaveTransaction = nullptr;
 
-    m_DocumentState = BuildDocumentState();
+    // commit of save transaction has updated the state already unless nothing was recorded
+    if (UpdateDocumentState(nullptr))
+        m_StateRevision++;
 }
 
 imgui_json::value Document::OnLoadNodeState(ID_TYPE nodeId) const
@@ -282,7 +713,7 @@ void Document::SetPath(std::string path)
 imgui_json::value Document::Serialize() const
 {
     imgui_json::value result;
-    result["document"] = m_DocumentState.Serialize();
+    result["document"] = GetDocumentState().Serialize();
     result["view"] = m_NavigationState.m_ViewState;
     return result;
 }
@@ -298,12 +729,13 @@ int Document::Deserialize(const imgui_json::value& value, Document& result)
     auto& documentValue = value["document"];
     auto& viewValue = value["view"];
 
-    if (DocumentState::Deserialize(documentValue, result.m_DocumentState) != 0)
+    if (DocumentState::Deserialize(documentValue, result.EditDocumentState()) != 0)
         return BP_ERR_DOC_LOAD;
 
     result.m_NavigationState.m_ViewState = viewValue;
+    result.m_StateRevision++;
 
-    if (result.m_Blueprint.Load(result.m_DocumentState.m_BlueprintState) != 0)
+    if (result.m_Blueprint.Load(result.m_DocumentState->m_BlueprintState) != 0)
         return BP_ERR_DOC_LOAD;
 
     return BP_ERR_NONE;
@@ -324,18 +756,87 @@ int Document::Load(std::string path)
 
 int Document::Import(std::string path, ImVec2 pos)
 {
-    int ret = BP_ERR_NONE;
-    auto loadResult = imgui_json::value::load(path);
-    if (!loadResult.second)
-        return BP_ERR_GROUP_LOAD;
+    return m_Blueprint.Import(path, pos);
+}
 
-    return m_Blueprint.Import(loadResult.first, pos);
+// new file next to path which no other save uses, written file keeps mode of the one it replaces
+static FILE* OpenTempFile(const std::string& path, std::string& temp_path)
+{
+#if !defined(_WIN32)
+    std::vector<char> name(path.begin(), path.end());
+    const char suffix[] = ".XXXXXX";
+    name.insert(name.end(), suffix, suffix + sizeof(suffix));
+    int fd = mkstemp(name.data());
+    if (fd < 0)
+        return nullptr;
+    struct stat st;
+    fchmod(fd, stat(path.c_str(), &st) == 0 ? (st.st_mode & 07777) : 0644);
+    temp_path = name.data();
+    auto file = fdopen(fd, "wb");
+    if (!file)
+    {
+        close(fd);
+        std::error_code ec;
+        std::filesystem::remove(temp_path, ec);
+    }
+    return file;
+#else
+    static std::atomic<uint32_t> s_TempIndex {0};
+    for (int i = 0; i < 16; i++)
+    {
+        temp_path = path + "." + std::to_string(_getpid()) + "." + std::to_string(s_TempIndex++) + ".tmp";
+        if (auto file = fopen(temp_path.c_str(), "wbx"))
+            return file;
+    }
+    return nullptr;
+#endif
+}
+
+bool Document::Save(std::string path, const DocumentState& state, const imgui_json::value& view)
+{
+    // same layout as Serialize(), states are streamed without copying them into a new DOM.
+    // file is written next to target and renamed over it, a crash never leaves half written document.
+    // temp name is unique, background and synchronous saves of same path never share it
+    std::string temp_path;
+    auto file = OpenTempFile(path, temp_path);
+    if (!file)
+        return false;
+    bool ret;
+    {
+        JsonWriter writer(file, 4);
+        writer.BeginObject();
+        writer.Key("document");
+        writer.BeginObject();
+        writer.Key("nodes");
+        writer.Value(state.m_NodesState);
+        writer.Key("selection");
+        writer.Value(state.m_SelectionState);
+        writer.Key("blueprint");
+        writer.Value(state.m_BlueprintState);
+        writer.EndObject();
+        writer.Key("view");
+        writer.Value(view);
+        writer.EndObject();
+        ret = writer.Flush();
+    }
+#if !defined(_WIN32) && !defined(__EMSCRIPTEN__)
+    ret = ret && fsync(fileno(file)) == 0;
+#endif
+    ret = (fclose(file) == 0) && ret;
+    std::error_code ec;
+    if (ret)
+        std::filesystem::rename(temp_path, path, ec);
+    if (!ret || ec)
+    {
+        std::filesystem::remove(temp_path, ec);
+        return false;
+    }
+    return true;
 }
 
 bool Document::Save(std::string path) const
 {
-    auto result = Serialize();
-    return result.save(path);
+    return Save(path, GetDocumentState(), m_NavigationState.m_ViewState);
 }
 
 bool Document::Save() const
@@ -352,16 +853,24 @@ bool Document::Undo()
 
     auto state = std::move(m_Undo.back());
     m_Undo.pop_back();
+    m_UndoMemory -= state.m_Size;
 
     LOGI("[Document] Undo: %s", state.m_Name.c_str());
 
-    UndoState undoState;
-    undoState.m_Name = state.m_Name;
-    undoState.m_State = m_DocumentState;
+    UndoState redoState;
+    redoState.m_Name = state.m_Name;
+    if (!PatchState(EditDocumentState(), state.m_Delta, redoState.m_Delta))
+    {
+        DropHistory("Undo", state.m_Name);
+        return false;
+    }
+    redoState.m_Size = ValueSize(redoState.m_Delta);
+    m_StateRevision++;
 
-    ApplyState(state.m_State);
+    ApplyState(*m_DocumentState);
 
-    m_Redo.push_back(std::move(undoState));
+    m_UndoMemory += redoState.m_Size;
+    m_Redo.push_back(std::move(redoState));
 
     return true;
 }
@@ -373,20 +882,367 @@ bool Document::Redo()
 
     auto state = std::move(m_Redo.back());
     m_Redo.pop_back();
+    m_UndoMemory -= state.m_Size;
 
     LOGI("[Document] Redo: %s", state.m_Name.c_str());
 
     UndoState undoState;
     undoState.m_Name = state.m_Name;
-    undoState.m_State = m_DocumentState;
+    if (!PatchState(EditDocumentState(), state.m_Delta, undoState.m_Delta))
+    {
+        DropHistory("Redo", state.m_Name);
+        return false;
+    }
+    undoState.m_Size = ValueSize(undoState.m_Delta);
+    m_StateRevision++;
 
-    ApplyState(state.m_State);
+    ApplyState(*m_DocumentState);
 
+    m_UndoMemory += undoState.m_Size;
     m_Undo.push_back(std::move(undoState));
+    TrimUndo();
+
+    return true;
+}
+
+void Document::PushUndo(UndoState&& state)
+{
+    for (auto& redoState : m_Redo)
+        m_UndoMemory -= redoState.m_Size;
+    m_Redo.clear();
+
+    state.m_Size = ValueSize(state.m_Delta);
+    m_UndoMemory += state.m_Size;
+    m_Undo.push_back(std::move(state));
+    TrimUndo();
+}
+
+void Document::TrimUndo()
+{
+    // latest step is always kept even if it alone is over the limit
+    while (m_UndoMemoryLimit && m_UndoMemory > m_UndoMemoryLimit && m_Undo.size() > 1)
+    {
+        m_UndoMemory -= m_Undo.front().m_Size;
+        m_Undo.pop_front();
+    }
+}
+
+void Document::ClearUndo()
+{
+    m_Undo.clear();
+    m_Redo.clear();
+    m_UndoMemory = 0;
+}
+
+void Document::DropHistory(const char* action, const string& name)
+{
+    // step was recorded against state which no longer exists, neither it nor older steps can be trusted
+    LOGE("[Document] %s: \"%s\" does not apply to current state, undo history is dropped", action, name.c_str());
+    ClearUndo();
+    UpdateDocumentState(nullptr);
+    m_StateRevision++;
+}
+
+bool Document::UpdateDocumentState(imgui_json::value* inverse)
+{
+    if (!m_StateSynced)
+    {
+        FlushPendingState();
+        m_Blueprint.TakeEditedNodes();
+        auto state = BuildDocumentState();
+        bool changed = inverse ? DiffState(state, *m_DocumentState, *inverse) : true;
+        m_DocumentState = std::make_shared<DocumentState>(std::move(state));
+        SyncNodeOrder();
+        m_ChangedNodeStates.clear();
+        m_SelectionChanged = false;
+        m_StateSynced = true;
+        return changed;
+    }
+
+    // autosave released state since last update, pending changes go in without copy
+    if (!m_Pending.empty() && m_DocumentState.use_count() == 1)
+        FlushPendingState();
+    const auto& current = *m_DocumentState;
+    if (!current.m_NodesState.is_object() || !current.m_BlueprintState.contains("nodes") || !current.m_BlueprintState["nodes"].is_array())
+        return FallbackUpdate(inverse);
+
+    auto nodes = m_Blueprint.GetNodes();
+    bool sameOrder = nodes.size() == m_NodeOrder.size();
+    for (size_t i = 0; sameOrder && i < nodes.size(); i++)
+        sameOrder = nodes[i]->m_ID == m_NodeOrder[i];
+
+    imgui_json::value delta;
+    if (sameOrder)
+    {
+        if (!UpdateNodeRecords(nodes, delta))
+            return FallbackUpdate(inverse);
+    }
+    else
+    {
+        // nodes were added, removed or reordered, state is changed in place
+        FlushPendingState();
+        auto& records = m_DocumentState->m_BlueprintState["nodes"].get<imgui_json::array>();
+        if (records.size() != m_NodeOrder.size())
+            return FallbackUpdate(inverse);
+        std::unordered_set<ID_TYPE> edited(m_UncachedNodes.begin(), m_UncachedNodes.end());
+        for (auto id : m_Blueprint.TakeEditedNodes())
+            edited.insert(id);
+
+        // kept nodes have to stay in the same order for keyed patch
+        std::vector<bool> kept(records.size(), false);
+        size_t last = 0;
+        for (auto node : nodes)
+        {
+            auto it = m_RecordIndex.find(node->m_ID);
+            if (it == m_RecordIndex.end())
+                continue;
+            if (it->second < last)
+                return FallbackUpdate(inverse);
+            last = it->second;
+            kept[it->second] = true;
+        }
+
+        // delta goes from new records back to old ones: changed records are patched back,
+        // added nodes are removed and removed nodes are inserted at their old place
+        imgui_json::value patched, removed, inserted;
+        imgui_json::array newRecords;
+        newRecords.reserve(nodes.size());
+        for (auto node : nodes)
+        {
+            imgui_json::value scratch;
+            auto it = m_RecordIndex.find(node->m_ID);
+            if (it == m_RecordIndex.end())
+            {
+                removed.push_back(imgui_json::number(node->m_ID));
+                m_ChangedNodeStates.insert(node->m_ID);
+                newRecords.push_back(m_Blueprint.SaveNode(node, scratch));
+                continue;
+            }
+            auto& record = records[it->second];
+            imgui_json::value patch;
+            if (edited.count(node->m_ID))
+            {
+                auto& saved = m_Blueprint.SaveNode(node, scratch);
+                if (DiffValue(saved, record, patch))
+                {
+                    imgui_json::value entry;
+                    entry.push_back(imgui_json::number(node->m_ID));
+                    entry.push_back(std::move(patch));
+                    patched.push_back(std::move(entry));
+                    newRecords.push_back(&saved == &scratch ? std::move(scratch) : saved);
+                    continue;
+                }
+            }
+            newRecords.push_back(std::move(record));
+        }
+        for (size_t i = 0; i < records.size(); i++)
+        {
+            if (kept[i])
+                continue;
+            imgui_json::value entry;
+            entry.push_back(i ? imgui_json::value(imgui_json::number(m_NodeOrder[i - 1])) : imgui_json::value());
+            entry.push_back(std::move(records[i]));
+            inserted.push_back(std::move(entry));
+            m_ChangedNodeStates.insert(m_NodeOrder[i]);
+        }
+        records = std::move(newRecords);
+        SyncNodeOrder();
+
+        if (!patched.is_null() || !removed.is_null() || !inserted.is_null())
+        {
+            auto& patch = delta["blueprint"]["o"]["nodes"];
+            if (!patched.is_null())  patch["k"] = std::move(patched);
+            if (!removed.is_null())  patch["x"] = std::move(removed);
+            if (!inserted.is_null()) patch["a"] = std::move(inserted);
+        }
+    }
+
+    // while autosave holds state, changes are kept in m_Pending instead of copying whole state
+    bool shared = m_DocumentState.use_count() > 1;
+    auto& state = *m_DocumentState;
+    const auto& stored = state;
+
+    imgui_json::value blueprintState;
+    m_Blueprint.SaveState(blueprintState);
+    const imgui_json::value* oldBlueprintState = m_Pending.m_HasBlueprintState ? &m_Pending.m_BlueprintState
+        : stored.m_BlueprintState.contains("state") ? &stored.m_BlueprintState["state"] : nullptr;
+    if (!oldBlueprintState || !EqualValue(blueprintState, *oldBlueprintState))
+    {
+        auto& old = delta["blueprint"]["o"]["state"]["v"];
+        if (shared)
+        {
+            if (oldBlueprintState)
+                old = *oldBlueprintState;
+            m_Pending.m_BlueprintState = std::move(blueprintState);
+            m_Pending.m_HasBlueprintState = true;
+        }
+        else
+        {
+            old = std::move(state.m_BlueprintState["state"]);
+            state.m_BlueprintState["state"] = std::move(blueprintState);
+        }
+    }
+
+    if (!m_ChangedNodeStates.empty())
+    {
+        const auto& nodeStates = stored.m_NodesState.get<imgui_json::object>();
+        for (auto id : m_ChangedNodeStates)
+        {
+            auto key = edd::Serialization::ToString(ed::NodeId(id));
+            auto value = m_Blueprint.FindNode(id) ? ed::GetState(ed::StateType::Node, id) : imgui_json::value();
+            const imgui_json::value* old = nullptr;
+            auto pending = m_Pending.m_NodeStates.find(key);
+            if (pending != m_Pending.m_NodeStates.end())
+                old = pending->second.is_null() ? nullptr : &pending->second;
+            else
+            {
+                auto it = nodeStates.find(key);
+                if (it != nodeStates.end())
+                    old = &it->second;
+            }
+            if (!old)
+            {
+                if (value.is_null())
+                    continue;
+                delta["nodes"]["d"].push_back(imgui_json::value(key));
+            }
+            else if (value.is_null())
+                delta["nodes"]["o"][key]["v"] = *old;
+            else
+            {
+                imgui_json::value patch;
+                if (!DiffValue(value, *old, patch))
+                    continue;
+                delta["nodes"]["o"][key] = std::move(patch);
+            }
+            if (shared)
+                m_Pending.m_NodeStates[key] = std::move(value);
+            else if (value.is_null())
+                state.m_NodesState.get<imgui_json::object>().erase(key);
+            else
+                state.m_NodesState[key] = std::move(value);
+        }
+        m_ChangedNodeStates.clear();
+    }
+
+    if (m_SelectionChanged)
+    {
+        auto selection = ed::GetState(ed::StateType::Selection);
+        const auto& old = m_Pending.m_HasSelection ? m_Pending.m_Selection : state.m_SelectionState;
+        if (!EqualValue(selection, old))
+        {
+            delta["selection"]["v"] = old;
+            if (shared)
+            {
+                m_Pending.m_Selection = std::move(selection);
+                m_Pending.m_HasSelection = true;
+            }
+            else
+                state.m_SelectionState = std::move(selection);
+        }
+        m_SelectionChanged = false;
+    }
+
+    if (delta.is_null())
+        return false;
+    if (inverse)
+        *inverse = std::move(delta);
+    return true;
+}
+
+bool Document::UpdateNodeRecords(span<Node*> nodes, imgui_json::value& delta)
+{
+    // same nodes in same order, records of nodes nobody marked dirty are not even looked at
+    bool shared = m_DocumentState.use_count() > 1;
+    const auto& current = *m_DocumentState;
+    const auto& records = current.m_BlueprintState["nodes"].get<imgui_json::array>();
+    if (records.size() != m_NodeOrder.size())
+        return false;
+    auto edited = m_Blueprint.TakeEditedNodes();
+    edited.insert(edited.end(), m_UncachedNodes.begin(), m_UncachedNodes.end());
+    if (edited.empty())
+        return true;
+    std::sort(edited.begin(), edited.end());
+    edited.erase(std::unique(edited.begin(), edited.end()), edited.end());
 
+    imgui_json::value patched;
+    for (auto id : edited)
+    {
+        auto it = m_RecordIndex.find(id);
+        if (it == m_RecordIndex.end())
+            continue;  // node was edited and removed meanwhile
+        auto node = nodes[it->second];
+        auto pending = m_Pending.m_Records.find(id);
+        const auto& old = pending != m_Pending.m_Records.end() ? pending->second : records[it->second];
+        imgui_json::value scratch, patch;
+        auto& saved = m_Blueprint.SaveNode(node, scratch);
+        if (!DiffValue(saved, old, patch))
+            continue;
+        imgui_json::value entry;
+        entry.push_back(imgui_json::number(id));
+        entry.push_back(std::move(patch));
+        patched.push_back(std::move(entry));
+        auto& target = shared ? m_Pending.m_Records[id] : m_DocumentState->m_BlueprintState["nodes"].get<imgui_json::array>()[it->second];
+        target = &saved == &scratch ? std::move(scratch) : saved;
+    }
+    if (!patched.is_null())
+        delta["blueprint"]["o"]["nodes"]["k"] = std::move(patched);
     return true;
 }
 
+void Document::SyncNodeOrder()
+{
+    m_NodeOrder.clear();
+    m_RecordIndex.clear();
+    m_UncachedNodes.clear();
+    for (auto node : m_Blueprint.GetNodes())
+    {
+        m_RecordIndex[node->m_ID] = m_NodeOrder.size();
+        m_NodeOrder.push_back(node->m_ID);
+        if (!node->ReportsEdits())
+            m_UncachedNodes.push_back(node->m_ID);
+    }
+}
+
+void Document::FlushPendingState() const
+{
+    if (m_Pending.empty())
+        return;
+    if (m_DocumentState.use_count() > 1)
+        m_DocumentState = std::make_shared<DocumentState>(*m_DocumentState);
+    auto& state = *m_DocumentState;
+    if (!m_Pending.m_Records.empty())
+    {
+        auto& records = state.m_BlueprintState["nodes"].get<imgui_json::array>();
+        for (auto& item : m_Pending.m_Records)
+        {
+            auto it = m_RecordIndex.find(item.first);
+            if (it != m_RecordIndex.end() && it->second < records.size())
+                records[it->second] = std::move(item.second);
+        }
+    }
+    for (auto& item : m_Pending.m_NodeStates)
+    {
+        if (item.second.is_null())
+            state.m_NodesState.get<imgui_json::object>().erase(item.first);
+        else
+            state.m_NodesState[item.first] = std::move(item.second);
+    }
+    if (m_Pending.m_HasSelection)
+        state.m_SelectionState = std::move(m_Pending.m_Selection);
+    if (m_Pending.m_HasBlueprintState)
+        state.m_BlueprintState["state"] = std::move(m_Pending.m_BlueprintState);
+    m_Pending = PendingState();
+}
+
+bool Document::FallbackUpdate(imgui_json::value* inverse)
+{
+    // state does not match m_NodeOrder, whole state is built and compared instead
+    LOGW("[Document] state is out of sync with blueprint, rebuilding it");
+    m_StateSynced = false;
+    return UpdateDocumentState(inverse);
+}
+
 Document::DocumentState Document::BuildDocumentState()
 {
     DocumentState result;
@@ -407,15 +1263,147 @@ void Document::ApplyState(const DocumentState& state)
     //m_Blueprint.Load(state.m_BlueprintState);
     // TODO::Dicky do we need load bp again since we already load on document
 
-    m_DocumentState = state;
-    ed::ApplyState(ed::StateType::Nodes, m_DocumentState.m_NodesState);
-    ed::ApplyState(ed::StateType::Selection, m_DocumentState.m_SelectionState);
+    if (&state != m_DocumentState.get())
+    {
+        m_DocumentState = std::make_shared<DocumentState>(state);
+        m_Pending = PendingState();
+        m_StateSynced = false;
+    }
+    else
+        FlushPendingState();
+    ed::ApplyState(ed::StateType::Nodes, m_DocumentState->m_NodesState);
+    ed::ApplyState(ed::StateType::Selection, m_DocumentState->m_SelectionState);
+}
+
+const Document::DocumentState& Document::GetDocumentState() const
+{
+    FlushPendingState();
+    return *m_DocumentState;
+}
+
+shared_ptr<const Document::DocumentState> Document::GetStateSnapshot() const
+{
+    FlushPendingState();
+    return m_DocumentState;
+}
+
+Document::DocumentState& Document::EditDocumentState()
+{
+    FlushPendingState();
+    // state is shared with autosave, copy on write
+    if (m_DocumentState.use_count() > 1)
+        m_DocumentState = std::make_shared<DocumentState>(*m_DocumentState);
+    // blueprint may not match edited state any more, next update rebuilds whole state
+    m_StateSynced = false;
+    return *m_DocumentState;
 }
 
 void Document::OnMakeCurrent()
 {
-    ApplyState(m_DocumentState);
+    ApplyState(GetDocumentState());
     ApplyState(m_NavigationState);
 }
 
+// ----[ DocumentAutoSave ]----
+DocumentAutoSave::~DocumentAutoSave()
+{
+    Stop();
+}
+
+void DocumentAutoSave::SetPath(std::string path)
+{
+    m_Path = path;
+}
+
+bool DocumentAutoSave::Update(Document& document)
+{
+    if (m_Interval <= 0.f)
+        return false;
+    auto now = ImGui::get_current_time_usec();
+    if (now - m_LastTime < (int64_t)(m_Interval * 1000000))
+        return false;
+    m_LastTime = now;
+    if (m_SavedDocument == &document && m_SavedRevision == document.m_StateRevision)
+        return false;
+    if (!Save(document))
+        return false;
+    m_SavedDocument = &document;
+    m_SavedRevision = document.m_StateRevision;
+    return true;
+}
+
+bool DocumentAutoSave::Save(Document& document, std::string path)
+{
+    if (path.empty())
+        path = m_Path;
+    if (path.empty() && !document.m_Path.empty())
+        path = document.m_Path + ".autosave";
+    if (path.empty())
+        return false;
+
+    // snapshot is a reference to current state, editing document later copies state on write
+    auto job = std::make_unique<Job>();
+    job->m_Path = path;
+    job->m_State = document.GetStateSnapshot();
+    job->m_View = document.m_NavigationState.m_ViewState;
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        if (!m_Thread.joinable())
+        {
+            m_Quit = false;
+            m_Thread = std::thread(&DocumentAutoSave::Worker, this);
+        }
+        // newer request replaces pending one of same file only
+        m_Pending[path] = std::move(job);
+        m_Busy = true;
+    }
+    m_Condition.notify_all();
+    return true;
+}
+
+void DocumentAutoSave::Wait()
+{
+    std::unique_lock<std::mutex> lock(m_Mutex);
+    m_Condition.wait(lock, [this] { return !m_Busy; });
+}
+
+void DocumentAutoSave::Stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_Quit = true;
+    }
+    m_Condition.notify_all();
+    if (m_Thread.joinable())
+        m_Thread.join();
+}
+
+void DocumentAutoSave::Worker()
+{
+    std::unique_lock<std::mutex> lock(m_Mutex);
+    while (true)
+    {
+        // pending save is still written when stopping
+        m_Condition.wait(lock, [this] { return m_Quit || !m_Pending.empty(); });
+        if (m_Pending.empty())
+            break;
+        auto job = std::move(m_Pending.begin()->second);
+        m_Pending.erase(m_Pending.begin());
+        lock.unlock();
+
+        bool ret = Document::Save(job->m_Path, *job->m_State, job->m_View);
+        if (!ret)
+            LOGE("[AutoSave] Failed to save \"%s\".", job->m_Path.c_str());
+        m_LastResult = ret;
+        job = nullptr;
+
+        lock.lock();
+        if (m_Pending.empty())
+        {
+            m_Busy = false;
+            m_Condition.notify_all();
+        }
+    }
+}
+
 } // namespace BluePrint
\ No newline at end of file
@@ -1,5 +1,8 @@
 #include <Icon.h>
 #include <imgui_internal.h>
+#include <string.h>
+#include <unordered_map>
+#include <vector>
 
 static void bezier_arc(ImVec2 center, ImVec2 start, ImVec2 end, ImVec2& c1, ImVec2 & c2)
 {
@@ -40,7 +43,7 @@ static void draw_arc(ImDrawList* draw_list, ImVec2 center, float radius, float s
 
 namespace BluePrint
 {
-void DrawIcon(ImDrawList* drawList, const ImVec2& a, const ImVec2& b, IconType type, bool filled, ImU32 color, ImU32 innerColor)
+static void DrawIconGeometry(ImDrawList* drawList, const ImVec2& a, const ImVec2& b, IconType type, bool filled, ImU32 color, ImU32 innerColor)
 {
             auto rect           = ImRect(a, b);
             auto rect_x         = rect.Min.x;
@@ -328,6 +331,121 @@ void DrawIcon(ImDrawList* drawList, const ImVec2& a, const ImVec2& b, IconType t
     }
 }
 
+// -----------------------------
+// --------[ Icon Cache ]--------
+// -----------------------------
+// Icon is tessellated once per type/size/filled, recorded with marker colors and stamped per pin
+// with pin colors. Geometry is recorded at fractional part of icon position, whole pixels are
+// added on stamp, so floor/ceil snapping inside DrawIconGeometry gives same result as before.
+// AA fringe follows drawlist fringe scale, node editor changes it with zoom, so it is in key too.
+
+static const ImU32 ICON_MARK_COLOR = IM_COL32(255, 0, 0, 255);
+static const ImU32 ICON_MARK_INNER = IM_COL32(0, 0, 255, 255);
+static const int   ICON_SUBPIXEL   = 8;     // fractional position steps per pixel
+static const int   ICON_CACHE_MAX  = 4096;  // cache is dropped as a whole beyond it, zoom animation makes new keys
+
+struct IconKey
+{
+    ImTextureID m_Texture;
+    float       m_Width;
+    float       m_Height;
+    float       m_FringeScale;
+    ImU32       m_Type;
+    ImU32       m_Flags;        // filled | inner << 1 | drawlist flags << 8
+    ImU32       m_Offset;       // fractional x | fractional y << 8
+
+    bool operator==(const IconKey& other) const { return memcmp(this, &other, sizeof(IconKey)) == 0; }
+};
+
+struct IconKeyHash
+{
+    size_t operator()(const IconKey& key) const { return ImHashData(&key, sizeof(IconKey)); }
+};
+
+struct IconMesh
+{
+    std::vector<ImDrawVert> m_Vertices;     // col: inner marker in blue channel, alpha is coverage
+    std::vector<ImDrawIdx>  m_Indices;      // relative to first vertex
+};
+
+static std::unordered_map<IconKey, IconMesh, IconKeyHash> s_IconCache;
+static bool s_IconCacheEnabled = true;
+
+static const IconMesh& GetIconMesh(ImDrawList* drawList, const IconKey& key, const ImVec2& offset, IconType type, bool filled, bool inner)
+{
+    auto it = s_IconCache.find(key);
+    if (it != s_IconCache.end())
+        return it->second;
+    if (s_IconCache.size() >= ICON_CACHE_MAX)
+        s_IconCache.clear();
+
+    ImDrawList scratch(drawList->_Data);
+    scratch._ResetForNewFrame();
+    scratch.Flags = drawList->Flags;
+    scratch._FringeScale = drawList->_FringeScale;
+    DrawIconGeometry(&scratch, offset, offset + ImVec2(key.m_Width, key.m_Height), type, filled, ICON_MARK_COLOR, inner ? ICON_MARK_INNER : 0);
+
+    auto& mesh = s_IconCache[key];
+    mesh.m_Vertices.assign(scratch.VtxBuffer.Data, scratch.VtxBuffer.Data + scratch.VtxBuffer.Size);
+    mesh.m_Indices.assign(scratch.IdxBuffer.Data, scratch.IdxBuffer.Data + scratch.IdxBuffer.Size);
+    return mesh;
+}
+
+void SetIconCacheEnabled(bool enabled)
+{
+    s_IconCacheEnabled = enabled;
+    s_IconCache.clear();
+}
+
+void DrawIcon(ImDrawList* drawList, const ImVec2& a, const ImVec2& b, IconType type, bool filled, ImU32 color, ImU32 innerColor)
+{
+    if (!s_IconCacheEnabled)
+    {
+        DrawIconGeometry(drawList, a, b, type, filled, color, innerColor);
+        return;
+    }
+    // fully transparent icon draws nothing, as every draw call below skips transparent color
+    bool inner = (innerColor & IM_COL32_A_MASK) != 0;
+    if ((color & IM_COL32_A_MASK) == 0 && !inner)
+        return;
+
+    ImVec2 base(floorf(a.x), floorf(a.y));
+    int fx = (int)((a.x - base.x) * ICON_SUBPIXEL + 0.5f);
+    int fy = (int)((a.y - base.y) * ICON_SUBPIXEL + 0.5f);
+    IconKey key;
+    memset(&key, 0, sizeof(IconKey));
+    key.m_Texture = drawList->_CmdHeader.TextureId;
+    key.m_Width = b.x - a.x;
+    key.m_Height = b.y - a.y;
+    key.m_FringeScale = drawList->_FringeScale;
+    key.m_Type = (ImU32)type;
+    key.m_Flags = (filled ? 1 : 0) | (inner ? 2 : 0) | ((ImU32)drawList->Flags << 8);
+    key.m_Offset = (ImU32)fx | ((ImU32)fy << 8);
+    auto& mesh = GetIconMesh(drawList, key, ImVec2((float)fx / ICON_SUBPIXEL, (float)fy / ICON_SUBPIXEL), type, filled, inner);
+    if (mesh.m_Indices.empty())
+        return;
+
+    const int vtx_count = (int)mesh.m_Vertices.size();
+    const int idx_count = (int)mesh.m_Indices.size();
+    drawList->PrimReserve(idx_count, vtx_count);
+    const ImDrawIdx first = (ImDrawIdx)drawList->_VtxCurrentIdx;
+    const ImU32 color_alpha = (color & IM_COL32_A_MASK) >> IM_COL32_A_SHIFT;
+    const ImU32 inner_alpha = (innerColor & IM_COL32_A_MASK) >> IM_COL32_A_SHIFT;
+    for (auto& vtx : mesh.m_Vertices)
+    {
+        bool is_inner = (vtx.col & IM_COL32(0, 0, 255, 0)) != 0;
+        ImU32 coverage = (vtx.col & IM_COL32_A_MASK) >> IM_COL32_A_SHIFT;
+        ImU32 alpha = (is_inner ? inner_alpha : color_alpha) * coverage / 255;
+        drawList->_VtxWritePtr->pos = vtx.pos + base;
+        drawList->_VtxWritePtr->uv = vtx.uv;
+        drawList->_VtxWritePtr->col = ((is_inner ? innerColor : color) & ~IM_COL32_A_MASK) | (alpha << IM_COL32_A_SHIFT);
+        drawList->_VtxWritePtr++;
+    }
+    for (auto idx : mesh.m_Indices)
+        *drawList->_IdxWritePtr++ = (ImDrawIdx)(first + idx);
+    drawList->_VtxCurrentIdx += vtx_count;
+}
+
 void Icon(const ImVec2& size, IconType type, bool filled, bool exported, bool publicized, const ImVec4& color/* = ImVec4(1, 1, 1, 1)*/, const ImVec4& innerColor/* = ImVec4(0, 0, 0, 0)*/)
 {
     if (ImGui::IsRectVisible(size))
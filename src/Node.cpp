@@ -3,6 +3,8 @@
 #include <imgui_node_editor_internal.h>
 #include <imgui_helper.h>
 #include <BuildInNodes.h> // Which is generated by cmake
+#include <cmath>
+#include <cstring>
 
 namespace BluePrint
 {
@@ -137,6 +139,7 @@ NodeRegistry::~NodeRegistry()
         delete node;
     }
     m_Nodes.clear();
+    m_Prototypes.clear();
     for (auto obj : m_ExternalObject)
     {
         delete obj;
@@ -147,49 +150,36 @@ NodeRegistry::~NodeRegistry()
 ID_TYPE NodeRegistry::RegisterNodeType(shared_ptr<NodeTypeInfo> info)
 {
     // regiester static node which has NodeTypeInfo
-    auto id = info->m_ID;
+    auto& typeInfo = StoreCustomType(*info);
+    InsertType(&typeInfo);
+    return typeInfo.m_ID;
+}
 
-    auto it = std::find_if(m_CustomNodes.begin(), m_CustomNodes.end(), [id](const NodeTypeInfo& typeInfo)
+ID_TYPE NodeRegistry::RegisterNodeType(std::string Path)
+{
+    NodeTypeModule module;
+    if (!LoadNodeType(Path, module))
     {
-        return typeInfo.m_ID == id;
-    });
-
-    if (it != m_CustomNodes.end())
-        m_CustomNodes.erase(it);
-
-    NodeTypeInfo typeInfo;
-    typeInfo.m_ID               = id;
-    typeInfo.m_Name             = info->m_Name;
-    typeInfo.m_NodeTypeName     = info->m_NodeTypeName;
-    typeInfo.m_Version          = info->m_Version;
-    typeInfo.m_SDK_Version      = info->m_SDK_Version;
-    typeInfo.m_API_Version      = info->m_API_Version;
-    typeInfo.m_Author           = info->m_Author;
-    typeInfo.m_Type             = info->m_Type;
-    typeInfo.m_Style            = info->m_Style;
-    typeInfo.m_Catalog          = info->m_Catalog;
-    typeInfo.m_Factory          = info->m_Factory;
-    typeInfo.m_Url              = info->m_Url;
-
-    m_CustomNodes.push_back(std::move(typeInfo));
-
-    RebuildTypes();
-
-    return id;
+        return 0;
+    }
+    m_ExternalObject.push_back(module.m_Object);
+    m_LazyModules.erase(module.m_Info->m_ID);
+    return RegisterNodeType(module.m_Info);
 }
 
-ID_TYPE NodeRegistry::RegisterNodeType(std::string Path)
+bool NodeRegistry::LoadNodeType(std::string Path, NodeTypeModule& module)
 {
+    module.m_Path = Path;
     auto dlobject = new DLClass<NodeTypeInfo>(Path.c_str());
     if (!dlobject)
     {
-        return 0;
+        return false;
     }
     auto info = dlobject->make_obj();
     if (!info)
     {
         delete dlobject;
-        return 0;
+        return false;
     }
 
     int32_t version = dlobject->get_version();
@@ -207,97 +197,249 @@ ID_TYPE NodeRegistry::RegisterNodeType(std::string Path)
                 VERSION_MAJOR(VERSION_BLUEPRINT_API), VERSION_MINOR(VERSION_BLUEPRINT_API), VERSION_PATCH(VERSION_BLUEPRINT_API));
     }
 
-    m_ExternalObject.push_back(dlobject);
     info->m_Url = ImGuiHelper::path_url(Path);
-    return RegisterNodeType(info);
+    module.m_Object = dlobject;
+    module.m_Info = info;
+    return true;
+}
+
+std::vector<ID_TYPE> NodeRegistry::RegisterNodeTypes(std::vector<NodeTypeModule>& modules)
+{
+    std::vector<ID_TYPE> ids;
+    ids.reserve(modules.size());
+    for (auto& module : modules)
+    {
+        if (!module.m_Info || (!module.m_Object && module.m_Path.empty()))
+        {
+            ids.push_back(0);
+            continue;
+        }
+        if (module.m_Object)
+        {
+            m_ExternalObject.push_back(module.m_Object);
+            module.m_Object = nullptr;
+            m_LazyModules.erase(module.m_Info->m_ID);
+        }
+        else
+        {
+            module.m_Info->m_Factory = nullptr;
+            m_LazyModules[module.m_Info->m_ID] = module.m_Path;
+        }
+        auto& typeInfo = StoreCustomType(*module.m_Info);
+        // prototype may come from build in node or older module which has same ID
+        ReleasePrototype(typeInfo.m_ID);
+        ids.push_back(typeInfo.m_ID);
+    }
+    RebuildTypes();
+    return ids;
 }
 
 void NodeRegistry::UnregisterNodeType(std::string name)
 {
-    auto it = std::find_if(m_CustomNodes.begin(), m_CustomNodes.end(), [name](const NodeTypeInfo& typeInfo)
+    auto it = std::find_if(m_CustomNodes.begin(), m_CustomNodes.end(), [name](const std::pair<const ID_TYPE, NodeTypeInfo>& entry)
     {
-        return typeInfo.m_Name == name;
+        return entry.second.m_Name == name;
     });
 
     if (it == m_CustomNodes.end())
         return;
 
+    auto id = it->first;
+    RemoveType(&it->second);
     m_CustomNodes.erase(it);
+    m_LazyModules.erase(id);
 
-    RebuildTypes();
+    // build in node with same ID is visible again
+    for (auto& typeInfo : m_BuildInNodes)
+    {
+        if (typeInfo.m_ID == id)
+        {
+            InsertType(&typeInfo);
+            break;
+        }
+    }
 }
 
 void NodeRegistry::RebuildTypes()
 {
     m_Types.resize(0);
-    m_Types.reserve(m_CustomNodes.size() + std::distance(std::begin(m_BuildInNodes), std::end(m_BuildInNodes)));
+    m_TypeIndex.clear();
+    m_NameIndex.clear();
+    m_Types.reserve(m_CustomNodes.size() + m_BuildInNodes.size());
 
-    for (auto& typeInfo : m_CustomNodes)
-        m_Types.push_back(&typeInfo);
+    // custom node override build in node which has same ID
+    for (auto& entry : m_CustomNodes)
+        m_TypeIndex[entry.first] = &entry.second;
 
     for (auto& typeInfo : m_BuildInNodes)
-        m_Types.push_back(&typeInfo);
+        m_TypeIndex.emplace(typeInfo.m_ID, &typeInfo);
+
+    for (auto& entry : m_TypeIndex)
+        m_Types.push_back(entry.second);
 
     std::sort(m_Types.begin(), m_Types.end(), [](const NodeTypeInfo* lhs, const NodeTypeInfo* rhs) { return lhs->m_ID < rhs->m_ID; });
-    m_Types.erase(std::unique(m_Types.begin(), m_Types.end()), m_Types.end());
 
-    // rebuild catalog
     for (auto type : m_Types)
     {
-        bool alread_in_list = false;
-        for (auto catalog : m_Catalogs)
-        {
-            if (catalog.compare(type->m_Catalog) == 0)
-            {
-                alread_in_list = true;
-                break;
-            }
-        }
-        if (!alread_in_list)
-        {
-            m_Catalogs.push_back(type->m_Catalog);
-        }
-        bool alread_in_nodes = false;
-        for (auto node : m_Nodes)
+        m_NameIndex.emplace(type->m_Name, type);
+        InsertCatalog(type->m_Catalog);
+    }
+}
+
+NodeTypeInfo& NodeRegistry::StoreCustomType(const NodeTypeInfo& info)
+{
+    auto id = info.m_ID;
+    auto it = m_CustomNodes.find(id);
+    if (it != m_CustomNodes.end())
+    {
+        // same type registered again, old prototype is belong to old factory
+        RemoveTypeName(&it->second);
+        ReleasePrototype(id);
+    }
+
+    auto& typeInfo = m_CustomNodes[id];
+    typeInfo.m_ID               = id;
+    typeInfo.m_Name             = info.m_Name;
+    typeInfo.m_NodeTypeName     = info.m_NodeTypeName;
+    typeInfo.m_Version          = info.m_Version;
+    typeInfo.m_SDK_Version      = info.m_SDK_Version;
+    typeInfo.m_API_Version      = info.m_API_Version;
+    typeInfo.m_Author           = info.m_Author;
+    typeInfo.m_Type             = info.m_Type;
+    typeInfo.m_Style            = info.m_Style;
+    typeInfo.m_Catalog          = info.m_Catalog;
+    typeInfo.m_Factory          = info.m_Factory;
+    typeInfo.m_Url              = info.m_Url;
+    return typeInfo;
+}
+
+void NodeRegistry::InsertType(NodeTypeInfo* info)
+{
+    auto id = info->m_ID;
+    auto pos = std::lower_bound(m_Types.begin(), m_Types.end(), id, [](const NodeTypeInfo* type, ID_TYPE id) { return type->m_ID < id; });
+    if (pos != m_Types.end() && (*pos)->m_ID == id)
+    {
+        if (*pos != info)
         {
-            if (node->GetTypeID() == type->m_ID)
-            {
-                alread_in_nodes = true;
-                break;
-            }
+            RemoveTypeName(*pos);
+            ReleasePrototype(id);
         }
-        if (!alread_in_nodes)
+        *pos = info;
+    }
+    else
+    {
+        m_Types.insert(pos, info);
+    }
+    m_TypeIndex[id] = info;
+
+    auto name = m_NameIndex.find(info->m_Name);
+    if (name == m_NameIndex.end())
+        m_NameIndex.emplace(info->m_Name, info);
+    else if (name->second->m_ID >= id)
+        name->second = info;
+
+    InsertCatalog(info->m_Catalog);
+}
+
+void NodeRegistry::RemoveType(const NodeTypeInfo* info)
+{
+    auto id = info->m_ID;
+    auto pos = std::lower_bound(m_Types.begin(), m_Types.end(), id, [](const NodeTypeInfo* type, ID_TYPE id) { return type->m_ID < id; });
+    if (pos == m_Types.end() || *pos != info)
+        return;
+
+    m_Types.erase(pos);
+    m_TypeIndex.erase(id);
+    RemoveTypeName(info);
+    ReleasePrototype(id);
+}
+
+void NodeRegistry::RemoveTypeName(const NodeTypeInfo* info)
+{
+    auto name = m_NameIndex.find(info->m_Name);
+    if (name == m_NameIndex.end() || name->second != info)
+        return;
+
+    m_NameIndex.erase(name);
+    // fall back to next type which has same name, m_Types is sorted so first match has lowest ID
+    for (auto type : m_Types)
+    {
+        if (type != info && type->m_Name == info->m_Name)
         {
-            auto node = Create(type->m_ID, nullptr);
-            if (node) m_Nodes.push_back(node);
+            m_NameIndex.emplace(type->m_Name, type);
+            break;
         }
     }
 }
 
-Node* NodeRegistry::Create(ID_TYPE typeId, BP* blueprint)
+void NodeRegistry::InsertCatalog(const std::string& catalog)
 {
-    for (auto& nodeInfo : m_Types)
-    {
-        if (nodeInfo->m_ID != typeId)
-            continue;
+    if (m_CatalogIndex.insert(catalog).second)
+        m_Catalogs.push_back(catalog);
+}
 
-        return nodeInfo->m_Factory(blueprint);
-    }
+void NodeRegistry::ReleasePrototype(ID_TYPE typeId)
+{
+    std::lock_guard<std::mutex> lock(m_PrototypeMutex);
+    auto it = m_Prototypes.find(typeId);
+    if (it == m_Prototypes.end())
+        return;
 
-    return nullptr;
+    auto node = it->second;
+    m_Prototypes.erase(it);
+    m_Nodes.erase(std::remove(m_Nodes.begin(), m_Nodes.end(), node), m_Nodes.end());
+    delete node;
 }
 
-Node* NodeRegistry::Create(std::string typeName, BP* blueprint)
+NodeTypeInfo::Factory NodeRegistry::ResolveFactory(NodeTypeInfo* info) const
 {
-    for (auto& nodeInfo : m_Types)
+    // m_Factory of a lazy type is written here, any read has to be under the same lock
+    std::lock_guard<std::mutex> lock(m_LazyMutex);
+    if (info->m_Factory)
+        return info->m_Factory;
+    auto it = m_LazyModules.find(info->m_ID);
+    if (it == m_LazyModules.end())
+        return nullptr;
+
+    NodeTypeModule module;
+    if (!LoadNodeType(it->second, module))
     {
-        if (nodeInfo->m_Name != typeName)
-            continue;
-
-        return nodeInfo->m_Factory(blueprint);
+        LOGE("[RegisterNodeType] Load Node Type %s from %s Failed\n", info->m_Name.c_str(), it->second.c_str());
+        m_LazyModules.erase(it);
+        return nullptr;
+    }
+    if (module.m_Info->m_ID != info->m_ID)
+    {
+        // plugin changed after manifest was written
+        LOGE("[RegisterNodeType] Node Type %s changed in %s\n", info->m_Name.c_str(), it->second.c_str());
+        delete module.m_Object;
+        m_LazyModules.erase(it);
+        return nullptr;
     }
+    m_ExternalObject.push_back(module.m_Object);
+    m_LazyModules.erase(it);
+    info->m_Factory = module.m_Info->m_Factory;
+    return info->m_Factory;
+}
 
-    return nullptr;
+Node* NodeRegistry::Create(ID_TYPE typeId, BP* blueprint)
+{
+    auto it = m_TypeIndex.find(typeId);
+    if (it == m_TypeIndex.end())
+        return nullptr;
+
+    auto factory = ResolveFactory(it->second);
+    return factory ? factory(blueprint) : nullptr;
+}
+
+Node* NodeRegistry::Create(std::string typeName, BP* blueprint)
+{
+    auto it = m_NameIndex.find(typeName);
+    if (it == m_NameIndex.end())
+        return nullptr;
+
+    auto factory = ResolveFactory(it->second);
+    return factory ? factory(blueprint) : nullptr;
 }
 
 span<const NodeTypeInfo* const> NodeRegistry::GetTypes() const
@@ -316,19 +458,130 @@ span<const std::string> NodeRegistry::GetCatalogs() const
 
 span<const Node * const> NodeRegistry::GetNodes() const
 {
+    for (auto type : m_Types)
+        GetPrototype(type->m_ID);
+
     const Node* const* begin = m_Nodes.data();
     const Node* const* end   = m_Nodes.data() + m_Nodes.size();
     return make_span(begin, end);
 }
 
+const Node* NodeRegistry::GetPrototype(ID_TYPE typeId) const
+{
+    std::lock_guard<std::mutex> lock(m_PrototypeMutex);
+    auto it = m_Prototypes.find(typeId);
+    if (it != m_Prototypes.end())
+        return it->second;
+
+    auto type = m_TypeIndex.find(typeId);
+    if (type == m_TypeIndex.end())
+        return nullptr;
+
+    auto factory = ResolveFactory(type->second);
+    auto node = factory ? factory(nullptr) : nullptr;
+    if (!node)
+        return nullptr;
+
+    m_Prototypes.emplace(typeId, node);
+    m_Nodes.push_back(node);
+    return node;
+}
+
 const NodeTypeInfo* NodeRegistry::GetTypeInfo(ID_TYPE typeId) const
 {
-    for (auto& nodeInfo : m_Types)
+    auto it = m_TypeIndex.find(typeId);
+    if (it != m_TypeIndex.end())
+        return it->second;
+    return nullptr;
+}
+
+// ----------------------------------
+// -------[ LatencyHistogram ]-------
+// ----------------------------------
+static inline int LatencyBucketIndex(uint64_t value)
+{
+    if (value < LatencyHistogram::SUB_BUCKET_COUNT)
+        return (int)value;
+    int msb = 63;
+    while (!(value >> msb)) msb--;
+    int shift = msb - LatencyHistogram::SUB_BUCKET_BITS;
+    return (shift + 1) * LatencyHistogram::SUB_BUCKET_COUNT + (int)((value >> shift) & (LatencyHistogram::SUB_BUCKET_COUNT - 1));
+}
+
+static inline uint64_t LatencyBucketUpperBound(int index)
+{
+    if (index < LatencyHistogram::SUB_BUCKET_COUNT)
+        return (uint64_t)index;
+    int shift = index / LatencyHistogram::SUB_BUCKET_COUNT - 1;
+    uint64_t sub = (uint64_t)(index % LatencyHistogram::SUB_BUCKET_COUNT) + LatencyHistogram::SUB_BUCKET_COUNT;
+    return (sub << shift) + ((uint64_t(1) << shift) - 1);
+}
+
+LatencyHistogram::~LatencyHistogram()
+{
+    delete[] m_Buckets.load(std::memory_order_relaxed);
+}
+
+void LatencyHistogram::Record(uint64_t value)
+{
+    auto buckets = m_Buckets.load(std::memory_order_acquire);
+    if (!buckets)
     {
-        if (nodeInfo->m_ID == typeId)
-            return nodeInfo;
+        // first sample, another recording thread may have won the race
+        auto created = new std::atomic<uint32_t>[BUCKET_COUNT]();
+        if (m_Buckets.compare_exchange_strong(buckets, created, std::memory_order_acq_rel))
+            buckets = created;
+        else
+            delete[] created;
     }
-    return nullptr;
+    // single writer, relaxed add is a plain add on common targets
+    buckets[LatencyBucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+    m_Count.fetch_add(1, std::memory_order_relaxed);
+    if (value > m_Max.load(std::memory_order_relaxed))
+        m_Max.store(value, std::memory_order_relaxed);
+}
+
+void LatencyHistogram::Reset()
+{
+    auto buckets = m_Buckets.load(std::memory_order_acquire);
+    if (!buckets || !m_Count.load(std::memory_order_relaxed))
+        return;
+    for (int i = 0; i < BUCKET_COUNT; i++)
+        buckets[i].store(0, std::memory_order_relaxed);
+    m_Count.store(0, std::memory_order_relaxed);
+    m_Max.store(0, std::memory_order_relaxed);
+}
+
+uint64_t LatencyHistogram::Percentile(double percent) const
+{
+    // buckets and count may be a few samples apart while recording goes on
+    auto count = m_Count.load(std::memory_order_relaxed);
+    auto max = m_Max.load(std::memory_order_relaxed);
+    auto buckets = m_Buckets.load(std::memory_order_acquire);
+    if (!count || !buckets)
+        return 0;
+    uint64_t rank = (uint64_t)std::ceil(percent / 100.0 * (double)count);
+    if (rank == 0)
+        rank = 1;
+    uint64_t seen = 0;
+    for (int i = 0; i < BUCKET_COUNT; i++)
+    {
+        seen += buckets[i].load(std::memory_order_relaxed);
+        if (seen >= rank)
+            return std::min(LatencyBucketUpperBound(i), max);
+    }
+    return max;
+}
+
+LatencyStats LatencyHistogram::GetStats() const
+{
+    LatencyStats stats;
+    stats.m_Count = m_Count.load(std::memory_order_relaxed);
+    stats.m_P50 = Percentile(50.0);
+    stats.m_P95 = Percentile(95.0);
+    stats.m_P99 = Percentile(99.0);
+    stats.m_Max = m_Max.load(std::memory_order_relaxed);
+    return stats;
 }
 
 // ----------------------
@@ -341,23 +594,43 @@ Node::Node(BP* blueprint)
     if (blueprint) m_ID = blueprint->MakeNodeID(this);
 }
 
+void* Node::operator new(size_t size)
+{
+    return BPArena::Allocate(nullptr, size);
+}
+
+void* Node::operator new(size_t size, BP* blueprint)
+{
+    return BPArena::Allocate(blueprint ? blueprint->GetArena() : nullptr, size);
+}
+
+void Node::operator delete(void* ptr)
+{
+    BPArena::Free(ptr);
+}
+
+void Node::operator delete(void* ptr, BP* blueprint)
+{
+    BPArena::Free(ptr);
+}
+
 unique_ptr<Pin> Node::CreatePin(PinType pinType, std::string name)
 {
     switch (pinType)
     {
         default:
         case PinType::Void:     return nullptr;
-        case PinType::Any:      return make_unique<AnyPin>(this, name);
-        case PinType::Flow:     return make_unique<FlowPin>(this, name);
-        case PinType::Bool:     return make_unique<BoolPin>(this, name);
-        case PinType::Int32:    return make_unique<Int32Pin>(this, name);
-        case PinType::Int64:    return make_unique<Int64Pin>(this, name);
-        case PinType::Float:    return make_unique<FloatPin>(this, name);
-        case PinType::Double:   return make_unique<DoublePin>(this, name);
-        case PinType::String:   return make_unique<StringPin>(this, name, "");
-        case PinType::Point:    return make_unique<PointPin>(this, name);
-        case PinType::Vec2:     return make_unique<Vec2Pin>(this, name);
-        case PinType::Vec4:     return make_unique<Vec4Pin>(this, name);
+        case PinType::Any:      return unique_ptr<Pin>(new (m_Blueprint) AnyPin(this, name));
+        case PinType::Flow:     return unique_ptr<Pin>(new (m_Blueprint) FlowPin(this, name));
+        case PinType::Bool:     return unique_ptr<Pin>(new (m_Blueprint) BoolPin(this, name));
+        case PinType::Int32:    return unique_ptr<Pin>(new (m_Blueprint) Int32Pin(this, name));
+        case PinType::Int64:    return unique_ptr<Pin>(new (m_Blueprint) Int64Pin(this, name));
+        case PinType::Float:    return unique_ptr<Pin>(new (m_Blueprint) FloatPin(this, name));
+        case PinType::Double:   return unique_ptr<Pin>(new (m_Blueprint) DoublePin(this, name));
+        case PinType::String:   return unique_ptr<Pin>(new (m_Blueprint) StringPin(this, name, ""));
+        case PinType::Point:    return unique_ptr<Pin>(new (m_Blueprint) PointPin(this, name));
+        case PinType::Vec2:     return unique_ptr<Pin>(new (m_Blueprint) Vec2Pin(this, name));
+        case PinType::Vec4:     return unique_ptr<Pin>(new (m_Blueprint) Vec4Pin(this, name));
     }
 
     return nullptr;
@@ -368,19 +641,19 @@ Pin * Node::NewPin(PinType pinType, std::string name)
     Pin * pin = nullptr;
     switch (pinType)
     {
-        case PinType::Any :     pin = new AnyPin(this, name); break;
-        case PinType::Flow :    pin = new FlowPin(this, name); break;
-        case PinType::Bool :    pin = new BoolPin(this, name); break;
-        case PinType::Int32 :   pin = new Int32Pin(this, name); break;
-        case PinType::Int64 :   pin = new Int64Pin(this, name); break;
-        case PinType::Float :   pin = new FloatPin(this, name); break;
-        case PinType::Double :  pin = new DoublePin(this, name); break;
-        case PinType::String :  pin = new StringPin(this, name, ""); break;
-        case PinType::Point :   pin = new PointPin(this, name); break;
-        case PinType::Vec2 :    pin = new Vec2Pin(this, name); break;
-        case PinType::Vec4 :    pin = new Vec4Pin(this, name); break;
-        case PinType::Mat :     pin = new MatPin(this, name); break;
-        case PinType::Array :   pin = new ArrayPin(this, name); break;
+        case PinType::Any :     pin = new (m_Blueprint) AnyPin(this, name); break;
+        case PinType::Flow :    pin = new (m_Blueprint) FlowPin(this, name); break;
+        case PinType::Bool :    pin = new (m_Blueprint) BoolPin(this, name); break;
+        case PinType::Int32 :   pin = new (m_Blueprint) Int32Pin(this, name); break;
+        case PinType::Int64 :   pin = new (m_Blueprint) Int64Pin(this, name); break;
+        case PinType::Float :   pin = new (m_Blueprint) FloatPin(this, name); break;
+        case PinType::Double :  pin = new (m_Blueprint) DoublePin(this, name); break;
+        case PinType::String :  pin = new (m_Blueprint) StringPin(this, name, ""); break;
+        case PinType::Point :   pin = new (m_Blueprint) PointPin(this, name); break;
+        case PinType::Vec2 :    pin = new (m_Blueprint) Vec2Pin(this, name); break;
+        case PinType::Vec4 :    pin = new (m_Blueprint) Vec4Pin(this, name); break;
+        case PinType::Mat :     pin = new (m_Blueprint) MatPin(this, name); break;
+        case PinType::Array :   pin = new (m_Blueprint) ArrayPin(this, name); break;
         default: break;
     }
     return pin;
@@ -442,11 +715,13 @@ std::string Node::GetURL() const
 void Node::SetName(std::string name)
 {
     m_Name = name;
+    MarkDirty();
 }
 
 void Node::SetBreakPoint(bool breaken)
 {
     m_BreakPoint = breaken;
+    MarkDirty();
 }
 
 bool Node::HasSetting() const
@@ -464,6 +739,19 @@ bool Node::CustomLayout() const
     return false;
 }
 
+void Node::MarkDirty()
+{
+    m_Dirty.store(true, std::memory_order_relaxed);
+    if (m_Blueprint)
+        m_Blueprint->NoteEdit(this);
+}
+
+bool Node::ReportsEdits() const
+{
+    // UI marks node dirty after settings and custom layout edits, pin values and links mark it themselves
+    return true;
+}
+
 void Node::DrawSettingLayout(ImGuiContext * ctx)
 {
     // Draw Setting
@@ -493,6 +781,7 @@ void Node::DrawSettingLayout(ImGuiContext * ctx)
         if (m_Name.compare(value) != 0)
         {
             m_Name = value;
+            MarkDirty();
             ed::SetNodeChanged(m_ID);
         }
     }
@@ -592,8 +881,12 @@ int Node::Load(const imgui_json::value& value)
     if (!value.is_object())
         return BP_ERR_NODE_LOAD;
 
+    MarkDirty();
+
     if (!imgui_json::GetTo<imgui_json::number>(value, "id", m_ID)) // required
         return BP_ERR_NODE_LOAD;
+    if (m_Blueprint)
+        m_Blueprint->TouchLinks(); // node is indexed under its old ID
 
     if (!imgui_json::GetTo<imgui_json::string>(value, "name", m_Name)) // required
         return BP_ERR_NODE_LOAD;
@@ -678,7 +971,7 @@ int Node::Load(const imgui_json::value& value)
     return BP_ERR_NONE;
 }
 
-void Node::Save(imgui_json::value& value, std::map<ID_TYPE, ID_TYPE> MapID)
+void Node::Save(imgui_json::value& value, const std::map<ID_TYPE, ID_TYPE>& MapID)
 {
     bool isRemap = MapID.size() > 0;
     value["id"] = imgui_json::number(GetIDFromMap(m_ID, MapID)); // required
@@ -725,5 +1018,40 @@ void Node::Save(imgui_json::value& value, std::map<ID_TYPE, ID_TYPE> MapID)
     if (outputPinsValue.is_null())
         value.erase("output_pins");
 }
+
+bool Node::CopyTo(Node& node, const std::map<ID_TYPE, ID_TYPE>& MapID)
+{
+    auto inputPins = GetInputPins();
+    auto outputPins = GetOutputPins();
+    auto nodeInputPins = node.GetInputPins();
+    auto nodeOutputPins = node.GetOutputPins();
+    if (inputPins.size() != nodeInputPins.size() || outputPins.size() != nodeOutputPins.size())
+        return false;
+
+    bool isRemap = MapID.size() > 0;
+    node.m_ID = GetIDFromMap(m_ID, MapID);
+    node.m_Name = m_Name;
+    node.m_Enabled = m_Enabled;
+    node.m_BreakPoint = m_BreakPoint;
+    if (m_GroupID) node.m_GroupID = GetIDFromMap(m_GroupID, MapID);
+
+    auto copyPins = [&](span<Pin*> src, span<Pin*> dst)
+    {
+        auto pin = dst.data();
+        for (auto srcPin : src)
+        {
+            if (!(*pin)->CopyFrom(*srcPin, MapID))
+                return false;
+            if (isRemap && ((*pin)->m_Flags & PIN_FLAG_EXPORTED))
+            {
+                (*pin)->m_Flags &= ~PIN_FLAG_EXPORTED;
+                (*pin)->m_Flags |= PIN_FLAG_PUBLICIZED;
+            }
+            ++pin;
+        }
+        return true;
+    };
+    return copyPins(inputPins, nodeInputPins) && copyPins(outputPins, nodeOutputPins);
+}
 } // namespace BluePrint
 
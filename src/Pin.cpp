@@ -89,6 +89,26 @@ Pin::~Pin()
         m_Node->m_Blueprint->ForgetPin(this);
 }
 
+void* Pin::operator new(size_t size)
+{
+    return BPArena::Allocate(nullptr, size);
+}
+
+void* Pin::operator new(size_t size, BP* blueprint)
+{
+    return BPArena::Allocate(blueprint ? blueprint->GetArena() : nullptr, size);
+}
+
+void Pin::operator delete(void* ptr)
+{
+    BPArena::Free(ptr);
+}
+
+void Pin::operator delete(void* ptr, BP* blueprint)
+{
+    BPArena::Free(ptr);
+}
+
 PinType Pin::GetType() const
 {
     return m_Type;
@@ -118,6 +138,7 @@ bool Pin::LinkTo(Pin& pin)
     if (m_Link)
         Unlink();
 
+    auto oldLink = m_Link;
     m_Link = pin.m_ID;
 
     m_Node->WasLinked(*this, pin);
@@ -129,6 +150,9 @@ bool Pin::LinkTo(Pin& pin)
     {
         pin.m_LinkFrom.push_back(m_ID);
     }
+    MarkDirty();
+    pin.MarkDirty();
+    if (m_Node->m_Blueprint) m_Node->m_Blueprint->UpdateLink(*this, oldLink);
     ed::SetPinChanged(pin.m_ID);
 
     return true;
@@ -144,6 +168,7 @@ void Pin::Unlink()
     if (!link)
         return;
 
+    auto oldLink = m_Link;
     m_Link = 0;
 
     m_Node->WasUnlinked(*this, *link);
@@ -166,6 +191,9 @@ void Pin::Unlink()
     {
         link->m_Flags &= ~PIN_FLAG_LINKED;
     }
+    MarkDirty();
+    link->MarkDirty();
+    bp->UpdateLink(*this, oldLink);
 
     ed::SetLinkChanged(link->m_ID);
 }
@@ -253,6 +281,12 @@ bool Pin::IsLinkedExportedPin() const
     return link_with_export;
 }
 
+void Pin::MarkDirty()
+{
+    if (m_Node)
+        m_Node->MarkDirty();
+}
+
 bool Pin::Load(const imgui_json::value& value)
 {
     string pinType;
@@ -262,6 +296,8 @@ bool Pin::Load(const imgui_json::value& value)
 
     if (!imgui_json::GetTo<imgui_json::number>(value, "id", m_ID)) // required
         return false;
+    if (m_Node && m_Node->m_Blueprint)
+        m_Node->m_Blueprint->TouchLinks(); // pin is indexed under its old ID
 
     if (value.contains("link"))
         imgui_json::GetTo<imgui_json::number>(value, "link", m_Link); // optional
@@ -290,7 +326,7 @@ bool Pin::Load(const imgui_json::value& value)
     return true;
 }
 
-void Pin::Save(imgui_json::value& value, std::map<ID_TYPE, ID_TYPE> MapID) const
+void Pin::Save(imgui_json::value& value, const std::map<ID_TYPE, ID_TYPE>& MapID) const
 {
     value["id"] = imgui_json::number(GetIDFromMap(m_ID, MapID)); // required
     value["type"] = PinTypeToString(m_Type);
@@ -314,6 +350,36 @@ void Pin::Save(imgui_json::value& value, std::map<ID_TYPE, ID_TYPE> MapID) const
         value.erase("link_from");
 }
 
+bool Pin::CopyFrom(const Pin& pin, const std::map<ID_TYPE, ID_TYPE>& MapID)
+{
+    m_ID = GetIDFromMap(pin.m_ID, MapID);
+    m_Type = pin.m_Type;
+    if (pin.m_Link) m_Link = GetIDFromMap(pin.m_Link, MapID);
+    m_MappedPin = GetIDFromMap(pin.m_MappedPin, MapID);
+    m_Flags = pin.m_Flags;
+    if (!pin.m_Name.empty())
+        m_Name = pin.m_Name;
+    std::vector<ID_TYPE> linkFrom;
+    for (auto& pinid : pin.m_LinkFrom)
+    {
+        auto ID = GetIDFromMap(pinid, MapID);
+        if (ID) linkFrom.push_back(ID);
+    }
+    if (!linkFrom.empty())
+        m_LinkFrom = std::move(linkFrom);
+    return true;
+}
+
+template <typename T>
+static bool CopyPinValue(T& dst, const Pin& src, const std::map<ID_TYPE, ID_TYPE>& MapID)
+{
+    auto pin = dynamic_cast<const T*>(&src);
+    if (!pin || !dst.Pin::CopyFrom(src, MapID))
+        return false;
+    dst.m_Value = pin->m_Value;
+    return true;
+}
+
 PinType Pin::GetValueType() const
 {
     return m_Type;
@@ -371,6 +437,8 @@ bool AnyPin::SetValueType(PinType type)
         m_InnerPin.reset();
     }
 
+    MarkDirty();
+
     if (type == PinType::Any)
         return true;
 
@@ -426,7 +494,7 @@ bool AnyPin::Load(const imgui_json::value& value)
     return true;
 }
 
-void AnyPin::Save(imgui_json::value& value, std::map<ID_TYPE, ID_TYPE> MapID) const
+void AnyPin::Save(imgui_json::value& value, const std::map<ID_TYPE, ID_TYPE>& MapID) const
 {
     Pin::Save(value, MapID);
     value["vtype"] = PinTypeToString(GetValueType());
@@ -434,6 +502,25 @@ void AnyPin::Save(imgui_json::value& value, std::map<ID_TYPE, ID_TYPE> MapID) co
         m_InnerPin->Save(value["inner"], MapID);
 }
 
+bool AnyPin::CopyFrom(const Pin& pin, const std::map<ID_TYPE, ID_TYPE>& MapID)
+{
+    auto anyPin = dynamic_cast<const AnyPin*>(&pin);
+    if (!anyPin || !Pin::CopyFrom(pin, MapID))
+        return false;
+
+    auto type = anyPin->GetValueType();
+    if (type != PinType::Any)
+    {
+        m_InnerPin = m_Node->CreatePin(type);
+        if (!m_InnerPin || !anyPin->m_InnerPin)
+            return false;
+        if (!m_InnerPin->CopyFrom(*anyPin->m_InnerPin, MapID))
+            return false;
+    }
+
+    return true;
+}
+
 // BoolPin
 bool BoolPin::Load(const imgui_json::value& value)
 {
@@ -444,12 +531,17 @@ bool BoolPin::Load(const imgui_json::value& value)
     return true;
 }
 
-void BoolPin::Save(imgui_json::value& value, std::map<ID_TYPE, ID_TYPE> MapID) const
+void BoolPin::Save(imgui_json::value& value, const std::map<ID_TYPE, ID_TYPE>& MapID) const
 {
     Pin::Save(value, MapID);
     value["value"] = m_Value; // required
 }
 
+bool BoolPin::CopyFrom(const Pin& pin, const std::map<ID_TYPE, ID_TYPE>& MapID)
+{
+    return CopyPinValue(*this, pin, MapID);
+}
+
 // Int32Pin
 bool Int32Pin::Load(const imgui_json::value& value)
 {
@@ -460,12 +552,17 @@ bool Int32Pin::Load(const imgui_json::value& value)
     return true;
 }
 
-void Int32Pin::Save(imgui_json::value& value, std::map<ID_TYPE, ID_TYPE> MapID) const
+void Int32Pin::Save(imgui_json::value& value, const std::map<ID_TYPE, ID_TYPE>& MapID) const
 {
     Pin::Save(value, MapID);
     value["value"] = imgui_json::number(m_Value); // required
 }
 
+bool Int32Pin::CopyFrom(const Pin& pin, const std::map<ID_TYPE, ID_TYPE>& MapID)
+{
+    return CopyPinValue(*this, pin, MapID);
+}
+
 // Int64Pin
 bool Int64Pin::Load(const imgui_json::value& value)
 {
@@ -476,12 +573,17 @@ bool Int64Pin::Load(const imgui_json::value& value)
     return true;
 }
 
-void Int64Pin::Save(imgui_json::value& value, std::map<ID_TYPE, ID_TYPE> MapID) const
+void Int64Pin::Save(imgui_json::value& value, const std::map<ID_TYPE, ID_TYPE>& MapID) const
 {
     Pin::Save(value, MapID);
     value["value"] = imgui_json::number(m_Value); // required
 }
 
+bool Int64Pin::CopyFrom(const Pin& pin, const std::map<ID_TYPE, ID_TYPE>& MapID)
+{
+    return CopyPinValue(*this, pin, MapID);
+}
+
 // FloatPin
 bool FloatPin::Load(const imgui_json::value& value)
 {
@@ -498,7 +600,7 @@ bool FloatPin::Load(const imgui_json::value& value)
     return true;
 }
 
-void FloatPin::Save(imgui_json::value& value, std::map<ID_TYPE, ID_TYPE> MapID) const
+void FloatPin::Save(imgui_json::value& value, const std::map<ID_TYPE, ID_TYPE>& MapID) const
 {
     Pin::Save(value, MapID);
     if (isnan(m_Value))
@@ -507,6 +609,11 @@ void FloatPin::Save(imgui_json::value& value, std::map<ID_TYPE, ID_TYPE> MapID)
         value["value"] = imgui_json::number(m_Value); // required
 }
 
+bool FloatPin::CopyFrom(const Pin& pin, const std::map<ID_TYPE, ID_TYPE>& MapID)
+{
+    return CopyPinValue(*this, pin, MapID);
+}
+
 // DoublePin
 bool DoublePin::Load(const imgui_json::value& value)
 {
@@ -523,7 +630,7 @@ bool DoublePin::Load(const imgui_json::value& value)
     return true;
 }
 
-void DoublePin::Save(imgui_json::value& value, std::map<ID_TYPE, ID_TYPE> MapID) const
+void DoublePin::Save(imgui_json::value& value, const std::map<ID_TYPE, ID_TYPE>& MapID) const
 {
     Pin::Save(value, MapID);
     if (isnan(m_Value))
@@ -532,6 +639,11 @@ void DoublePin::Save(imgui_json::value& value, std::map<ID_TYPE, ID_TYPE> MapID)
         value["value"] = imgui_json::number(m_Value); // required
 }
 
+bool DoublePin::CopyFrom(const Pin& pin, const std::map<ID_TYPE, ID_TYPE>& MapID)
+{
+    return CopyPinValue(*this, pin, MapID);
+}
+
 // StringPin
 bool StringPin::Load(const imgui_json::value& value)
 {
@@ -542,12 +654,17 @@ bool StringPin::Load(const imgui_json::value& value)
     return true;
 }
 
-void StringPin::Save(imgui_json::value& value, std::map<ID_TYPE, ID_TYPE> MapID) const
+void StringPin::Save(imgui_json::value& value, const std::map<ID_TYPE, ID_TYPE>& MapID) const
 {
     Pin::Save(value, MapID);
     value["value"] = m_Value; // required
 }
 
+bool StringPin::CopyFrom(const Pin& pin, const std::map<ID_TYPE, ID_TYPE>& MapID)
+{
+    return CopyPinValue(*this, pin, MapID);
+}
+
 // PointPin
 bool PointPin::Load(const imgui_json::value& value)
 {
@@ -560,7 +677,7 @@ bool PointPin::Load(const imgui_json::value& value)
     return true;
 }
 
-void PointPin::Save(imgui_json::value& value, std::map<ID_TYPE, ID_TYPE> MapID) const
+void PointPin::Save(imgui_json::value& value, const std::map<ID_TYPE, ID_TYPE>& MapID) const
 {
     Pin::Save(value, MapID);
     // do we need load/save point value into json?
@@ -578,7 +695,7 @@ bool ArrayPin::Load(const imgui_json::value& value)
     return true;
 }
 
-void ArrayPin::Save(imgui_json::value& value, std::map<ID_TYPE, ID_TYPE> MapID) const
+void ArrayPin::Save(imgui_json::value& value, const std::map<ID_TYPE, ID_TYPE>& MapID) const
 {
     Pin::Save(value, MapID);
     // TODO::Dicky ArrayPin save
@@ -597,12 +714,17 @@ bool Vec2Pin::Load(const imgui_json::value& value)
     return true;
 }
 
-void Vec2Pin::Save(imgui_json::value& value, std::map<ID_TYPE, ID_TYPE> MapID) const
+void Vec2Pin::Save(imgui_json::value& value, const std::map<ID_TYPE, ID_TYPE>& MapID) const
 {
     Pin::Save(value, MapID);
     value["vec"] = ed::Detail::Serialization::ToJson(m_Value);
 }
 
+bool Vec2Pin::CopyFrom(const Pin& pin, const std::map<ID_TYPE, ID_TYPE>& MapID)
+{
+    return CopyPinValue(*this, pin, MapID);
+}
+
 // Vec4Pin
 bool Vec4Pin::Load(const imgui_json::value& value)
 {
@@ -619,12 +741,17 @@ bool Vec4Pin::Load(const imgui_json::value& value)
     return true;
 }
 
-void Vec4Pin::Save(imgui_json::value& value, std::map<ID_TYPE, ID_TYPE> MapID) const
+void Vec4Pin::Save(imgui_json::value& value, const std::map<ID_TYPE, ID_TYPE>& MapID) const
 {
     Pin::Save(value, MapID);
     value["vec"] = ed::Detail::Serialization::ToJson(m_Value);
 }
 
+bool Vec4Pin::CopyFrom(const Pin& pin, const std::map<ID_TYPE, ID_TYPE>& MapID)
+{
+    return CopyPinValue(*this, pin, MapID);
+}
+
 // MatPin
 bool MatPin::Load(const imgui_json::value& value)
 {
@@ -633,7 +760,7 @@ bool MatPin::Load(const imgui_json::value& value)
     return true;
 }
 
-void MatPin::Save(imgui_json::value& value, std::map<ID_TYPE, ID_TYPE> MapID) const
+void MatPin::Save(imgui_json::value& value, const std::map<ID_TYPE, ID_TYPE>& MapID) const
 {
     Pin::Save(value, MapID);
 }
@@ -665,7 +792,7 @@ bool CustomPin::SyncValue()
     return false;
 }
 
-void CustomPin::Save(imgui_json::value& value, std::map<ID_TYPE, ID_TYPE> MapID) const
+void CustomPin::Save(imgui_json::value& value, const std::map<ID_TYPE, ID_TYPE>& MapID) const
 {
     Pin::Save(value, MapID);
     value["extype_name"] = m_ExTypeName;
@@ -682,6 +809,17 @@ bool CustomPin::Load(const imgui_json::value& value)
     return true;
 }
 
+bool CustomPin::CopyFrom(const Pin& pin, const std::map<ID_TYPE, ID_TYPE>& MapID)
+{
+    auto customPin = dynamic_cast<const CustomPin*>(&pin);
+    if (!customPin || !Pin::CopyFrom(pin, MapID))
+        return false;
+    m_ExTypeName = customPin->m_ExTypeName;
+
+    InitPinEx();
+    return true;
+}
+
 LinkQueryResult CustomPin::CanLinkTo(const Pin& pin) const
 {
     LinkQueryResult lqres = Pin::CanLinkTo(pin);
@@ -708,58 +846,119 @@ LinkQueryResult CustomPin::CanLinkTo(const Pin& pin) const
 
 PinExRegistry::~PinExRegistry()
 {
-    if (m_dll_handle)
-        dlclose(m_dll_handle);
+    for (auto handle : m_DllHandles)
+        dlclose(handle);
+    m_DllHandles.clear();
 }
 
-const PinTypeEx* PinExRegistry::RegisterPinEx(std::string module_path)
+bool PinExRegistry::LoadPinEx(std::string module_path, PinExModule& module)
 {
-    m_dll_handle = dlopen(module_path.c_str(), RTLD_LAZY);
-	if (!m_dll_handle) {
+    module.m_Path = module_path;
+    void* dll_handle = dlopen(module_path.c_str(), RTLD_LAZY);
+	if (!dll_handle) {
 		std::cerr << "Failed to open library: " << dlerror() << std::endl;
-		return nullptr;
+		return false;
 	}
 
 	// Reset errors
 	dlerror();
 
-	GET_PINEX_MODULE_INFO_FN* pfnGetPinExModuleInfo = (GET_PINEX_MODULE_INFO_FN*) dlsym(m_dll_handle, "GetPinExModuleInfo");
+	GET_PINEX_MODULE_INFO_FN* pfnGetPinExModuleInfo = (GET_PINEX_MODULE_INFO_FN*) dlsym(dll_handle, "GetPinExModuleInfo");
 	const char* err = dlerror();
 	if (err) {
 		std::cerr << "Failed to load version symbol: " << err << std::endl;
-		dlclose(m_dll_handle);
-        m_dll_handle = nullptr;
-		return nullptr;
+		dlclose(dll_handle);
+		return false;
 	}
 
     const PinExModuleInfo* pModInfo = pfnGetPinExModuleInfo();
     if (pModInfo == nullptr) {
         std::cerr << "PinExModulueInfo is NULL from '" << module_path << "'!" << std::endl;
-        dlclose(m_dll_handle);
-        m_dll_handle = nullptr;
-        return nullptr;
+        dlclose(dll_handle);
+        return false;
     }
 
-    for (auto pInfo : m_TypeInfos) {
-        if (pInfo->m_TypeEx == pModInfo->m_TypeEx) {
-            std::cerr << "Conflict PinTypeEx '" << pModInfo->m_TypeEx.GetName() << "', FAILED to load PinEx from '" << module_path << "'!" << std::endl;
-            dlclose(m_dll_handle);
-            m_dll_handle = nullptr;
-            return nullptr;
+    module.m_Handle = dll_handle;
+    module.m_Info = pModInfo;
+    return true;
+}
+
+const PinTypeEx* PinExRegistry::RegisterPinEx(std::string module_path)
+{
+    std::vector<PinExModule> modules(1);
+    if (!LoadPinEx(module_path, modules[0]))
+        return nullptr;
+    return RegisterPinExs(modules)[0];
+}
+
+const PinTypeEx* PinExRegistry::RegisterPinEx(const PinExModuleInfo* info)
+{
+    if (!info)
+        return nullptr;
+    std::unique_lock<std::shared_mutex> lock(m_Mutex);
+    return InsertPinEx(info, "");
+}
+
+std::vector<const PinTypeEx*> PinExRegistry::RegisterPinExs(std::vector<PinExModule>& modules)
+{
+    std::vector<const PinTypeEx*> types;
+    types.reserve(modules.size());
+    std::unique_lock<std::shared_mutex> lock(m_Mutex);
+    for (auto& module : modules)
+    {
+        if (!module.m_Handle || !module.m_Info)
+        {
+            types.push_back(nullptr);
+            continue;
+        }
+        auto type = InsertPinEx(module.m_Info, module.m_Path);
+        if (type)
+        {
+            m_DllHandles.push_back(module.m_Handle);
+        }
+        else
+        {
+            dlclose(module.m_Handle);
+            module.m_Info = nullptr;
         }
+        module.m_Handle = nullptr;
+        types.push_back(type);
     }
+    return types;
+}
 
-    m_TypeInfos.push_back(pModInfo);
-    return &pModInfo->m_TypeEx;
+const PinTypeEx* PinExRegistry::InsertPinEx(const PinExModuleInfo* info, const std::string& module_path)
+{
+    if (FindTypeInfo(info->m_TypeEx.GetName())) {
+        std::cerr << "Conflict PinTypeEx '" << info->m_TypeEx.GetName() << "', FAILED to load PinEx from '" << module_path << "'!" << std::endl;
+        return nullptr;
+    }
+
+    m_TypeInfos.push_back(info);
+    m_TypeIndex.emplace(fnv1a_hash_32(info->m_TypeEx.GetName()), info);
+    return &info->m_TypeEx;
 }
 
-PinEx* PinExRegistry::Create(std::string typeName)
+const PinExModuleInfo* PinExRegistry::FindTypeInfo(const std::string& typeName) const
 {
-    for (auto typeInfo : m_TypeInfos) {
-        if (typeInfo->m_TypeEx.GetName() == typeName) {
-            return typeInfo->m_CreatorFn();
-        }
+    auto range = m_TypeIndex.equal_range(fnv1a_hash_32(typeName));
+    for (auto it = range.first; it != range.second; ++it)
+    {
+        if (it->second->m_TypeEx.GetName() == typeName)
+            return it->second;
     }
     return nullptr;
 }
+
+const PinExModuleInfo* PinExRegistry::GetTypeInfo(const std::string& typeName) const
+{
+    std::shared_lock<std::shared_mutex> lock(m_Mutex);
+    return FindTypeInfo(typeName);
+}
+
+PinEx* PinExRegistry::Create(const std::string& typeName)
+{
+    auto typeInfo = GetTypeInfo(typeName);
+    return typeInfo ? typeInfo->m_CreatorFn() : nullptr;
+}
 }
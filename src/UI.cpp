@@ -2,9 +2,15 @@
 #include <BuildInNodes.h> // Which is generated by cmake
 #include <imgui_node_editor_internal.h>
 #include <iomanip>
+#include <condition_variable>
+#include <functional>
+#include <filesystem>
 #include <utility>
+#include <stdlib.h>
 #define THUMBNAIL_COUNT     100
 #define THUMBNAIL_HIDDEN    30
+#define FLOW_DURATION       1.0f    // seconds flow markers move after ShowFlow
+#define UPDATE_SETTLE_TIME  0.5     // seconds frames go on after input, covers node editor navigation animation
 #define DEBUG_NODE_DRAWING  0
 #define DEBUG_GROUP_NODE    0
 extern std::mutex g_Mutex;
@@ -303,10 +309,13 @@ void NodeSettingDialog::Show(BluePrintUI& UI)
         ImGui::Text("%" PRI_node "\n", FMT_node(node));
         ImGui::Separator();
         node->DrawSettingLayout(ImGui::GetCurrentContext());
+        // settings change node members live, record is written again while dialog is open
+        node->MarkDirty();
         ImGui::Separator();
         if (ImGui::Button("OK", ImVec2(120, 0))) 
         {
             UI.File_MarkModified();
+            node->MarkDirty();
             ed::SetNodeChanged(node->m_ID);
             ImGui::CloseCurrentPopup();
             if (UI.m_CallBacks.BluePrintOnChanged)
@@ -490,63 +499,335 @@ int BluePrintUI::CheckPlugins(const std::vector<std::string>& pluginPaths)
     return plugin_number;
 }
 
-void BluePrintUI::LoadPlugins(const std::vector<std::string>& pluginPaths, int& current_index, std::string& current_message, float& loading_percentage, int expect_count)
+// run job(index) for index in [0, count) on worker threads, caller thread call progress until all jobs done
+static void ParallelFor(size_t count, std::function<void(size_t)> job, std::function<void(size_t)> progress)
+{
+    if (count == 0)
+        return;
+    size_t worker_count = std::max<size_t>(1, std::min<size_t>(std::thread::hardware_concurrency(), count));
+    std::atomic<size_t> next_index {0};
+    std::atomic<size_t> done_count {0};
+    std::mutex done_mutex;
+    std::condition_variable done_cond;
+    std::vector<std::thread> workers;
+    for (size_t i = 0; i < worker_count; i++)
+    {
+        workers.emplace_back([&]()
+        {
+            size_t index;
+            while ((index = next_index.fetch_add(1)) < count)
+            {
+                job(index);
+                {
+                    std::lock_guard<std::mutex> lock(done_mutex);
+                    done_count ++;
+                }
+                done_cond.notify_one();
+            }
+        });
+    }
+    size_t reported = 0;
+    while (reported < count)
+    {
+        {
+            std::unique_lock<std::mutex> lock(done_mutex);
+            done_cond.wait(lock, [&]() { return done_count.load() > reported; });
+            reported = done_count.load();
+        }
+        if (progress) progress(reported);
+    }
+    for (auto& worker : workers)
+        worker.join();
+}
+
+// plugin manifest, cache node type info of plugin keyed by path, mtime and size
+struct PluginManifestEntry
+{
+    std::string     m_MTime;
+    int64_t         m_Size  {0};
+    NodeTypeInfo    m_Info;
+};
+
+// per user cache folder, empty when it can't be found
+static std::filesystem::path GetUserCachePath()
+{
+#if defined(_WIN32)
+    const char* base = getenv("LOCALAPPDATA");
+    if (base && *base) return std::filesystem::path(base);
+#elif defined(__APPLE__)
+    const char* home = getenv("HOME");
+    if (home && *home) return std::filesystem::path(home) / "Library" / "Caches";
+#else
+    const char* base = getenv("XDG_CACHE_HOME");
+    if (base && *base) return std::filesystem::path(base);
+    const char* home = getenv("HOME");
+    if (home && *home) return std::filesystem::path(home) / ".cache";
+#endif
+    return std::filesystem::path();
+}
+
+static std::string GetApplicationName()
+{
+#if defined(__linux__)
+    std::error_code ec;
+    auto exe_path = std::filesystem::read_symlink("/proc/self/exe", ec);
+    if (!ec && !exe_path.stem().empty()) return exe_path.stem().string();
+#elif defined(__APPLE__)
+    const char* name = getprogname();
+    if (name && *name) return std::string(name);
+#endif
+    return "blueprint";
+}
+
+// every host keeps own manifest in user cache folder, hosts with other plugin folders don't evict its entries
+static std::string GetPluginManifestPath(const std::string& manifest_path)
+{
+    if (!manifest_path.empty())
+        return manifest_path;
+    auto cache_path = GetUserCachePath();
+    if (cache_path.empty())
+        return std::string();
+    cache_path /= "BluePrintSDK";
+    std::error_code ec;
+    std::filesystem::create_directories(cache_path, ec);
+    if (ec) return std::string();
+    return (cache_path / (GetApplicationName() + "_plugins.json")).string();
+}
+
+// plugin is in one of scanned folders, a missing one was removed from there
+static bool IsScannedPlugin(const std::string& plugin_path, const std::vector<std::string>& pluginPaths)
+{
+    auto folder = (std::filesystem::path(plugin_path).parent_path() / "").lexically_normal();
+    for (auto& path : pluginPaths)
+    {
+        if ((std::filesystem::path(path) / "").lexically_normal() == folder)
+            return true;
+    }
+    return false;
+}
+
+static std::map<std::string, PluginManifestEntry> LoadPluginManifest(const std::string& path)
+{
+    std::map<std::string, PluginManifestEntry> manifest;
+    if (path.empty())
+        return manifest;
+    auto loadResult = imgui_json::value::load(path);
+    if (!loadResult.second)
+        return manifest;
+    auto& value = loadResult.first;
+    int32_t sdk_version = 0, api_version = 0;
+    if (!imgui_json::GetTo<imgui_json::number>(value, "sdk_version", sdk_version) || sdk_version != VERSION_BLUEPRINT ||
+        !imgui_json::GetTo<imgui_json::number>(value, "api_version", api_version) || api_version != VERSION_BLUEPRINT_API)
+        return manifest; // host changed, plugins need to be checked again
+    const imgui_json::array* pluginArray = nullptr;
+    if (!imgui_json::GetPtrTo(value, "plugins", pluginArray))
+        return manifest;
+    for (auto& pluginValue : *pluginArray)
+    {
+        std::string plugin_path;
+        PluginManifestEntry entry;
+        int32_t type = 0, style = 0;
+        auto& info = entry.m_Info;
+        if (!imgui_json::GetTo<imgui_json::string>(pluginValue, "path", plugin_path) ||
+            !imgui_json::GetTo<imgui_json::string>(pluginValue, "mtime", entry.m_MTime) ||
+            !imgui_json::GetTo<imgui_json::number>(pluginValue, "size", entry.m_Size) ||
+            !imgui_json::GetTo<imgui_json::number>(pluginValue, "id", info.m_ID) ||
+            !imgui_json::GetTo<imgui_json::string>(pluginValue, "type_name", info.m_NodeTypeName) ||
+            !imgui_json::GetTo<imgui_json::string>(pluginValue, "name", info.m_Name) ||
+            !imgui_json::GetTo<imgui_json::string>(pluginValue, "author", info.m_Author) ||
+            !imgui_json::GetTo<imgui_json::number>(pluginValue, "version", info.m_Version) ||
+            !imgui_json::GetTo<imgui_json::number>(pluginValue, "node_sdk_version", info.m_SDK_Version) ||
+            !imgui_json::GetTo<imgui_json::number>(pluginValue, "node_api_version", info.m_API_Version) ||
+            !imgui_json::GetTo<imgui_json::number>(pluginValue, "type", type) ||
+            !imgui_json::GetTo<imgui_json::number>(pluginValue, "style", style) ||
+            !imgui_json::GetTo<imgui_json::string>(pluginValue, "catalog", info.m_Catalog))
+            continue;
+        info.m_Type = (NodeType)type;
+        info.m_Style = (NodeStyle)style;
+        info.m_Factory = nullptr;
+        info.m_Url = ImGuiHelper::path_url(plugin_path);
+        manifest[plugin_path] = entry;
+    }
+    return manifest;
+}
+
+static void SavePluginManifest(const std::string& path, const std::map<std::string, PluginManifestEntry>& manifest)
+{
+    if (path.empty())
+        return;
+    imgui_json::value value;
+    value["sdk_version"] = imgui_json::number(VERSION_BLUEPRINT);
+    value["api_version"] = imgui_json::number(VERSION_BLUEPRINT_API);
+    auto& pluginArray = value["plugins"];
+    pluginArray = imgui_json::array();
+    for (auto& it : manifest)
+    {
+        auto& info = it.second.m_Info;
+        imgui_json::value pluginValue;
+        pluginValue["path"] = it.first;
+        pluginValue["mtime"] = it.second.m_MTime;
+        pluginValue["size"] = imgui_json::number(it.second.m_Size);
+        pluginValue["id"] = imgui_json::number(info.m_ID);
+        pluginValue["type_name"] = info.m_NodeTypeName;
+        pluginValue["name"] = info.m_Name;
+        pluginValue["author"] = info.m_Author;
+        pluginValue["version"] = imgui_json::number(info.m_Version);
+        pluginValue["node_sdk_version"] = imgui_json::number(info.m_SDK_Version);
+        pluginValue["node_api_version"] = imgui_json::number(info.m_API_Version);
+        pluginValue["type"] = imgui_json::number((int32_t)info.m_Type);
+        pluginValue["style"] = imgui_json::number((int32_t)info.m_Style);
+        pluginValue["catalog"] = info.m_Catalog;
+        pluginArray.push_back(pluginValue);
+    }
+    if (!value.save(path))
+    {
+        LOGW("Save plugin manifest %s failed", path.c_str());
+    }
+}
+
+void BluePrintUI::LoadPlugins(const std::vector<std::string>& pluginPaths, int& current_index, std::string& current_message, float& loading_percentage, int expect_count, std::string manifest_path)
 {
-    // load dynamic node
     auto nodeRegistry = BP::GetNodeRegistry();
+    auto pinexRegistry = BP::GetPinExRegistry();
     current_index = 0;
-    for (auto& plugin_path : pluginPaths)
+
+    // scan plugin folders
+    std::vector<std::vector<std::string>> node_plugins(pluginPaths.size());
+    std::vector<std::vector<std::string>> pin_plugins(pluginPaths.size());
+    ParallelFor(pluginPaths.size(), [&](size_t index)
     {
-        std::vector<std::string> plugins, plugin_names;
+        std::vector<std::string> plugin_names;
         std::vector<std::string> node_filter = {"node"};
         std::vector<std::string> pin_filter = {"pin"};
-        if (DIR_Iterate(plugin_path, plugins, plugin_names, node_filter, false) == 0)
-        {
-            LOGI("Load Extra Node %s", plugin_real_path.c_str());
-            for (auto node_path : plugins)
+        if (DIR_Iterate(pluginPaths[index], node_plugins[index], plugin_names, node_filter, false) != 0)
+            node_plugins[index].clear();
+        plugin_names.clear();
+        if (DIR_Iterate(pluginPaths[index], pin_plugins[index], plugin_names, pin_filter, false) != 0)
+            pin_plugins[index].clear();
+    }, nullptr);
+
+    // load dynamic node, plugin which is unchanged since last start is registered from manifest
+    // and opened at first use, others are opened and create type info in parallel, register all at once
+    manifest_path = GetPluginManifestPath(manifest_path);
+    auto manifest = LoadPluginManifest(manifest_path);
+    // entries of folders which are not scanned this time are carried over untouched
+    std::map<std::string, PluginManifestEntry> new_manifest;
+    for (auto& it : manifest)
+    {
+        if (!IsScannedPlugin(it.first, pluginPaths))
+            new_manifest.insert(it);
+    }
+    std::vector<NodeRegistry::NodeTypeModule> node_modules;
+    std::vector<NodeRegistry::NodeTypeModule> open_modules;
+    std::vector<PluginManifestEntry> open_stamps;
+    for (size_t i = 0; i < pluginPaths.size(); i++)
+    {
+        if (!node_plugins[i].empty()) LOGI("Load Extra Node %s", pluginPaths[i].c_str());
+        for (auto& node_path : node_plugins[i])
+        {
+            NodeRegistry::NodeTypeModule module;
+            module.m_Path = node_path;
+            PluginManifestEntry stamp;
+            bool has_stamp = GetFileStamp(node_path, stamp.m_MTime, stamp.m_Size);
+            auto cached = has_stamp ? manifest.find(node_path) : manifest.end();
+            if (cached != manifest.end() && cached->second.m_MTime == stamp.m_MTime && cached->second.m_Size == stamp.m_Size)
             {
+                module.m_Info = make_shared<NodeTypeInfo>(cached->second.m_Info);
+                new_manifest[node_path] = cached->second;
+                node_modules.push_back(module);
                 current_index ++;
-                if (expect_count > 0) loading_percentage = std::min((float)current_index / (float)expect_count, 1.f);
-                auto nodetypeid = nodeRegistry->RegisterNodeType(node_path);
-                if (nodetypeid == 0)
-                {
-                    LOGE("Load Extra Node Failed %s", node_path.c_str());
-                    continue;
-                }
-                auto nodeinfo = nodeRegistry->GetTypeInfo(nodetypeid);
-                if (!nodeinfo)
-                {
-                    LOGE("Load Extra Node Failed %s", node_path.c_str());
-                    continue;
-                }
-                LOGI("Load Extra Node %s(%d.%d.%d.%d)", nodeinfo->m_NodeTypeName.c_str(),
-                                                        VERSION_MAJOR(nodeinfo->m_Version), 
-                                                        VERSION_MINOR(nodeinfo->m_Version), 
-                                                        VERSION_PATCH(nodeinfo->m_Version), 
-                                                        VERSION_BUILT(nodeinfo->m_Version));
-                current_message = nodeinfo->m_Name;
+                continue;
             }
+            if (!has_stamp) stamp.m_MTime.clear();
+            open_modules.push_back(module);
+            open_stamps.push_back(stamp);
         }
+    }
+    if (expect_count > 0) loading_percentage = std::min((float)current_index / (float)expect_count, 1.f);
 
-        // load dynamic pin
-        auto pinexRegistry = BP::GetPinExRegistry();
-        plugins.clear(); plugin_names.clear();
-        if (DIR_Iterate(plugin_path, plugins, plugin_names, pin_filter, false) == 0)
+    // pin plugins are opened by the same workers
+    std::vector<PinExRegistry::PinExModule> pin_modules;
+    for (size_t i = 0; i < pluginPaths.size(); i++)
+    {
+        if (!pin_plugins[i].empty()) LOGI("Load Extra PinEx %s", pluginPaths[i].c_str());
+        for (auto& pinex_path : pin_plugins[i])
         {
-            current_index ++;
-            if (expect_count > 0) loading_percentage = std::min((float)current_index / (float)expect_count, 1.f);
-            LOGI("Load Extra PinEx %s", plugin_real_path.c_str());
-            for (auto pinex_path : plugins)
+            PinExRegistry::PinExModule module;
+            module.m_Path = pinex_path;
+            pin_modules.push_back(module);
+        }
+    }
+
+    std::mutex message_mutex;
+    std::string loaded_message;
+    int cached_count = current_index;
+    ParallelFor(open_modules.size() + pin_modules.size(), [&](size_t index)
+    {
+        if (index < open_modules.size())
+        {
+            auto& module = open_modules[index];
+            if (NodeRegistry::LoadNodeType(module.m_Path, module))
             {
-                auto pPinexType = pinexRegistry->RegisterPinEx(pinex_path);
-                if (pPinexType == nullptr) {
-                    LOGE("FAILED to load PinEx from '%s'!", pinex_path.c_str());
-                    continue;
-                }
-                LOGI("Successfully loaded PinEx from '%s'!", pinex_path.c_str());
-                current_message = pPinexType->GetName();
+                std::lock_guard<std::mutex> lock(message_mutex);
+                loaded_message = module.m_Info->m_Name;
             }
         }
+        else
+        {
+            auto& module = pin_modules[index - open_modules.size()];
+            if (PinExRegistry::LoadPinEx(module.m_Path, module))
+            {
+                std::lock_guard<std::mutex> lock(message_mutex);
+                loaded_message = module.m_Info->m_TypeEx.GetName();
+            }
+        }
+    }, [&](size_t loaded)
+    {
+        current_index = cached_count + loaded;
+        if (expect_count > 0) loading_percentage = std::min((float)current_index / (float)expect_count, 1.f);
+        std::lock_guard<std::mutex> lock(message_mutex);
+        current_message = loaded_message;
+    });
+    for (size_t i = 0; i < open_modules.size(); i++)
+    {
+        auto& module = open_modules[i];
+        if (module.m_Info && !open_stamps[i].m_MTime.empty())
+        {
+            auto& entry = new_manifest[module.m_Path];
+            entry.m_MTime = open_stamps[i].m_MTime;
+            entry.m_Size = open_stamps[i].m_Size;
+            entry.m_Info = *module.m_Info;
+        }
+        node_modules.push_back(module);
+    }
+    if (!open_modules.empty() || new_manifest.size() != manifest.size())
+        SavePluginManifest(manifest_path, new_manifest);
+
+    auto nodetypeids = nodeRegistry->RegisterNodeTypes(node_modules);
+    for (size_t i = 0; i < node_modules.size(); i++)
+    {
+        auto nodeinfo = nodetypeids[i] != 0 ? nodeRegistry->GetTypeInfo(nodetypeids[i]) : nullptr;
+        if (!nodeinfo)
+        {
+            LOGE("Load Extra Node Failed %s", node_modules[i].m_Path.c_str());
+            continue;
+        }
+        LOGI("Load Extra Node %s(%d.%d.%d.%d)", nodeinfo->m_NodeTypeName.c_str(),
+                                                VERSION_MAJOR(nodeinfo->m_Version), 
+                                                VERSION_MINOR(nodeinfo->m_Version), 
+                                                VERSION_PATCH(nodeinfo->m_Version), 
+                                                VERSION_BUILT(nodeinfo->m_Version));
+    }
+
+    // register dynamic pin
+    auto pinex_types = pinexRegistry->RegisterPinExs(pin_modules);
+    for (size_t i = 0; i < pin_modules.size(); i++)
+    {
+        if (pinex_types[i] == nullptr) {
+            LOGE("FAILED to load PinEx from '%s'!", pin_modules[i].m_Path.c_str());
+            continue;
+        }
+        LOGI("Successfully loaded PinEx from '%s'!", pin_modules[i].m_Path.c_str());
     }
 }
 
@@ -614,6 +895,7 @@ void BluePrintUI::Initialize(const char * bp_file)
 
 void BluePrintUI::Finalize()
 {
+    m_AutoSave.Stop();
     ed::SetCurrentEditor(m_Editor);
     if (m_Document) m_Document->Save();
     m_Document = nullptr;
@@ -762,11 +1044,13 @@ void BluePrintUI::SetCallbacks(BluePrintCallbackFunctions callbacks, void * hand
     m_UserHandle = handle;
 }
 
-bool BluePrintUI::Frame(bool child_window, bool show_node, bool bp_enabled, uint32_t flag)
+bool BluePrintUI::Frame(bool child_window, bool show_node, bool bp_enabled, uint32_t flag, bool* need_update)
 {
     bool done = false;
+    if (need_update) *need_update = false;
     if (!m_Editor || !m_Document || ReadyToQuit)
         return true;
+    m_AutoSave.Update(*m_Document);
     auto& io = ImGui::GetIO();
     bool multiviewport = io.ConfigFlags & ImGuiConfigFlags_ViewportsEnable;
     const ImGuiViewport* viewport = ImGui::GetMainViewport();
@@ -861,9 +1145,39 @@ bool BluePrintUI::Frame(bool child_window, bool show_node, bool bp_enabled, uint
     }
 
     EndOpRecord();
+    if (need_update) *need_update = CheckNeedUpdate();
     return done;
 }
 
+bool BluePrintUI::CheckNeedUpdate()
+{
+    // Another frame is needed while input settles, document changes, execution runs,
+    // flow markers move, thumbnails fade or autosave is writing
+    auto& io = ImGui::GetIO();
+    auto& blueprint = m_Document->m_Blueprint;
+    double now = ImGui::GetTime();
+    bool input = io.MouseDelta.x != 0 || io.MouseDelta.y != 0 || io.MouseWheel != 0 || io.MouseWheelH != 0 ||
+                io.InputQueueCharacters.Size > 0 || ImGui::IsAnyMouseDown() || ImGui::IsAnyItemActive();
+    for (int i = 0; i < IM_ARRAYSIZE(io.MouseReleased) && !input; i++)
+        input = io.MouseReleased[i];
+    for (int key = ImGuiKey_NamedKey_BEGIN; key < ImGuiKey_NamedKey_END && !input; key++)
+        input = ImGui::IsKeyDown((ImGuiKey)key) || ImGui::IsKeyReleased((ImGuiKey)key);
+    bool changed = blueprint.GetLinkRevision() != m_UpdateLinkRevision || m_Document->m_StateRevision != m_UpdateStateRevision;
+    m_UpdateLinkRevision = blueprint.GetLinkRevision();
+    m_UpdateStateRevision = m_Document->m_StateRevision;
+    if (input || changed)
+        m_UpdateUntil = now + UPDATE_SETTLE_TIME;
+
+    bool isThreadRunning = blueprint.IsExecuting() && !blueprint.IsPaused();
+    return now < m_UpdateUntil || now < m_FlowUntil || isThreadRunning || m_ThumbnailShowCount > 0 || m_AutoSave.IsSaving();
+}
+
+void BluePrintUI::ShowFlow()
+{
+    m_Document->m_Blueprint.ShowFlow();
+    m_FlowUntil = ImGui::GetTime() + FLOW_DURATION;
+}
+
 void BluePrintUI::CreateNewDocument()
 {
     auto blueprint = &m_Document->m_Blueprint;
@@ -1096,6 +1410,7 @@ float BluePrintUI::DrawNodeToolBar(Node *node, Node **need_clone_node)
             node->m_Enabled = !node->m_Enabled;
             if (node->m_Enabled) LOGI("[HandleNodeToolBar] Enable for %" PRI_node, FMT_node(node));
             else                 LOGI("[HandleNodeToolBar] Disable for %" PRI_node, FMT_node(node));
+            node->MarkDirty();
             ed::SetNodeChanged(node->m_ID);
             if (m_CallBacks.BluePrintOnChanged)
             {
@@ -1171,11 +1486,17 @@ bool BluePrintUI::CheckNodeStyle(const Node* node, NodeStyle style)
 void BluePrintUI::CommitLinksToEditor()
 {
     auto pins = m_Document->m_Blueprint.GetPins();
+    auto view_rect = ed::GetViewRect();
     for (auto pin : pins)
     {
         if (!pin->m_Link)
         {
-            if (!(pin->m_Flags & PIN_FLAG_LINKED)) pin->m_LinkFrom.clear();
+            if (!(pin->m_Flags & PIN_FLAG_LINKED) && !pin->m_LinkFrom.empty())
+            {
+                pin->m_LinkFrom.clear();
+                pin->MarkDirty();
+                m_Document->m_Blueprint.TouchLinks();
+            }
             continue;
         }
 
@@ -1183,27 +1504,47 @@ void BluePrintUI::CommitLinksToEditor()
         if (!link)
         {
             pin->m_Link = 0;
+            pin->MarkDirty();
+            m_Document->m_Blueprint.TouchLinks();
             continue;
         }
 
-        if (std::find(pins.begin(), pins.end(), link) == pins.end())
-        {
-            pin->m_Link = 0;
-            continue;
-        }
-        
+        // GetLink() looks up pin index of this blueprint, a found link is always one of pins
         // To keep things simple, link id is same as pin id.
         // check link is between bridge and shadow
         //bool inner_link = pin->IsMappedPin() && link->IsMappedPin() && pin->m_MappedPin && pin->m_MappedPin == link->m_MappedPin;
         //ed::Link(pin->m_ID, pin->m_ID, pin->m_Link, (inner_link ? ImVec4(0, 0, 0,  0) : PinTypeToColor(this, pin->GetValueType())), 1.5); // Maybe add to setting
-        ed::Link(pin->m_ID, pin->m_ID, pin->m_Link, PinTypeToColor(this, pin->GetValueType()), 3.0); // Maybe add to setting
-        pin->m_Flags |= PIN_FLAG_LINKED;
-        link->m_Flags |= PIN_FLAG_LINKED;
+        bool link_culled = false;
+        if (!m_CulledNodes.empty() && pin->m_Node && link->m_Node)
+        {
+            // both ends culled, link still crosses the view if their span does
+            auto from = m_CulledNodes.find(pin->m_Node->m_ID);
+            auto to = m_CulledNodes.find(link->m_Node->m_ID);
+            if (from != m_CulledNodes.end() && to != m_CulledNodes.end())
+            {
+                ImRect span = from->second;
+                span.Add(to->second);
+                link_culled = !span.Overlaps(view_rect) && !ed::IsLinkSelected(pin->m_ID);
+            }
+        }
+        if (!link_culled)
+            ed::Link(pin->m_ID, pin->m_ID, pin->m_Link, PinTypeToColor(this, pin->GetValueType()), 3.0); // Maybe add to setting
+        if (!(pin->m_Flags & PIN_FLAG_LINKED) || !(link->m_Flags & PIN_FLAG_LINKED))
+        {
+            pin->m_Flags |= PIN_FLAG_LINKED;
+            link->m_Flags |= PIN_FLAG_LINKED;
+            pin->MarkDirty();
+            link->MarkDirty();
+            m_Document->m_Blueprint.TouchLinks();
+        }
         if (std::find(link->m_LinkFrom.begin(), link->m_LinkFrom.end(), pin->m_ID) == link->m_LinkFrom.end())
         {
             link->m_LinkFrom.push_back(pin->m_ID);
+            link->MarkDirty();
+            m_Document->m_Blueprint.TouchLinks();
         }
     }
+    m_CulledNodes.clear();
 }
 
 ImVec2 BluePrintUI::Blueprint_EstimateNodeSize(Node* node)
@@ -1544,6 +1885,12 @@ void BluePrintUI::DrawNodes()
     }
 
     // Handling Default and SimpleNode
+    // Nodes out of view and all nodes when zoomed far out are committed as bare frames,
+    // nodes without a size yet need one full layout first
+    auto view_rect = ed::GetViewRect();
+    view_rect.Expand(iconSize.x * 4);
+    bool isFarView = m_LodZoom > 0 && ed::GetCurrentZoom() > m_LodZoom;
+    m_CulledNodes.clear();
     for (auto& node : m_Document->m_Blueprint.GetNodes())
     {
         auto isDummy = node->GetStyle() == NodeStyle::Dummy;
@@ -1551,6 +1898,22 @@ void BluePrintUI::DrawNodes()
         if (!CheckNodeStyle(node, NodeStyle::Default) && !CheckNodeStyle(node, NodeStyle::Simple))
             continue;
         node->m_IconHovered = -1;
+        auto storedSize = ed::GetNodeSize(node->m_ID);
+        if (storedSize.x > 0 && storedSize.y > 0 && (m_isCullNodes || isFarView))
+        {
+            auto nodeStart = ed::GetNodePosition(node->m_ID);
+            ImRect bounds(nodeStart, nodeStart + storedSize);
+            bool isCulled = m_isCullNodes && !view_rect.Overlaps(bounds);
+            if (isCulled || isFarView)
+            {
+                DrawNodeStub(node, storedSize);
+                if (isCulled)
+                    m_CulledNodes[node->m_ID] = bounds;
+                else if (m_DebugOverlay)
+                    m_DebugOverlay->DrawNode(this, *node);
+                continue;
+            }
+        }
         if (isDummy)
         {
             ed::PushStyleColor(ed::StyleColor_NodeBorder,    ImColor(255, 32,  32, 200));
@@ -1601,6 +1964,7 @@ void BluePrintUI::DrawNodes()
                 auto pos = itemMin + ImVec2(6, (itemMax.y - itemMin.y) / 2 - size.y / 2);
                 if (ImGui::BulletToggleButton("##set_break_point", &node->m_BreakPoint, pos, size))
                 {
+                    node->MarkDirty();
                     ed::SetNodeChanged(node->m_ID);
                 }
                 //ImGui::Debug_DrawItemRect();
@@ -1694,6 +2058,7 @@ void BluePrintUI::DrawNodes()
             ImVec2 origin = ed::GetCurrentOrigin();
             if (node->DrawCustomLayout(ImGui::GetCurrentContext(), zoom, origin))
             {
+                node->MarkDirty();
                 ed::SetNodeChanged(node->m_ID);
                 if (m_CallBacks.BluePrintOnChanged)
                 {
@@ -1794,10 +2159,12 @@ void BluePrintUI::DrawNodes()
     bool isThreadPaused = m_Document->m_Blueprint.IsPaused();
     if (isThreadExecuting && !isThreadPaused && m_DebugOverlay && !m_isChildWindow)
     {
+        // monitor slot may hold a tracer, it gets its place back after the overlay
         g_Mutex.lock();
+        auto monitor = m_Document->m_Blueprint.GetContextMonitor();
         m_Document->m_Blueprint.SetContextMonitor(m_DebugOverlay->GetContextMonitor());
-        m_Document->m_Blueprint.ShowFlow();
-        m_Document->m_Blueprint.SetContextMonitor(nullptr);
+        ShowFlow();
+        m_Document->m_Blueprint.SetContextMonitor(monitor);
         g_Mutex.unlock();
     }
 
@@ -1809,6 +2176,43 @@ void BluePrintUI::DrawNodes()
     if (m_DebugOverlay) m_DebugOverlay->End();
 }
 
+// Bare frame of stored size keeps node bounds for selection, navigation and group membership,
+// pins are spread along both sides so links still have their ends
+void BluePrintUI::DrawNodeStub(Node* node, const ImVec2& node_size)
+{
+    const auto iconSize = ImVec2(ImGui::GetTextLineHeight(), ImGui::GetTextLineHeight());
+    const auto& padding = ed::GetStyle().NodePadding;
+    auto isDummy = node->GetStyle() == NodeStyle::Dummy;
+    if (isDummy)
+        ed::PushStyleColor(ed::StyleColor_NodeBorder, m_StyleColors[BluePrintStyleColor_DummyBorder]);
+    if (node->m_NoBackGround)
+        ed::PushStyleColor(ed::StyleColor_NodeBg, ImVec4(0.f, 0.f, 0.f, 0.f));
+    ed::BeginNode(node->m_ID);
+    auto nodeStart = ed::GetNodePosition(node->m_ID);
+    ImGui::Dummy(ImMax(node_size - ImVec2(padding.x + padding.z, padding.y + padding.w), ImVec2(1, 1)));
+    auto commit_pins = [&](const auto& pins, ed::PinKind kind)
+    {
+        float x = kind == ed::PinKind::Input ? nodeStart.x : nodeStart.x + node_size.x - iconSize.x;
+        float step = node_size.y / (pins.size() + 1);
+        float y = nodeStart.y - iconSize.y / 2;
+        for (auto& pin : pins)
+        {
+            y += step;
+            ed::BeginPin(pin->m_ID, kind);
+            ed::PinPivotAlignment(ImVec2(kind == ed::PinKind::Input ? 0.0f : 1.0f, 0.5f));
+            ed::PinRect(ImVec2(x, y), ImVec2(x, y) + iconSize);
+            ed::EndPin();
+        }
+    };
+    commit_pins(node->GetInputPins(), ed::PinKind::Input);
+    commit_pins(node->GetOutputPins(), ed::PinKind::Output);
+    if (node->m_NoBackGround)
+        ed::PopStyleColor();
+    ed::EndNode();
+    if (isDummy)
+        ed::PopStyleColor();
+}
+
 void BluePrintUI::DrawInfoTooltip()
 {
     if (!m_Document || !ed::IsActive())
@@ -2057,6 +2461,8 @@ void BluePrintUI::DrawInfoTooltip()
                         {
                             hoveredPin->m_Flags |= PIN_FLAG_PUBLICIZED;
                         }
+                        hoveredPin->MarkDirty();
+                        m_Document->m_Blueprint.TouchLinks();
                         ed::SetPinChanged(hoveredPin->m_ID);
                         File_MarkModified();
                     }
@@ -2104,6 +2510,21 @@ void BluePrintUI::DrawInfoTooltip()
                 std::string consuming_text = oss.str() + (hoveredNode->m_Tick > 1000000 ? "s" : hoveredNode->m_Tick > 1000 ? "ms" : "us");
                 ImGui::Bullet(); ImGui::TextUnformatted(" Consuming:"); ImGui::SameLine(); ImGui::Text("%s", consuming_text.c_str());
                 ImGui::Bullet(); ImGui::TextUnformatted(" Node Time:"); ImGui::SameLine(); ImGui::Text("%.3fms", hoveredNode->m_NodeTimeMs);
+                LatencyStats latency;
+                if (m_Document->m_Blueprint.GetNodeLatency(hoveredNode->m_ID, latency) && latency.m_Count > 0)
+                {
+                    auto latency_text = [](uint64_t us)
+                    {
+                        char text[32];
+                        if (us >= 1000000) snprintf(text, sizeof(text), "%.2fs", us / 1000000.0);
+                        else if (us >= 1000) snprintf(text, sizeof(text), "%.2fms", us / 1000.0);
+                        else snprintf(text, sizeof(text), "%" PRIu64 "us", us);
+                        return std::string(text);
+                    };
+                    ImGui::Bullet(); ImGui::TextUnformatted("   Latency:"); ImGui::SameLine();
+                    ImGui::Text("p50 %s  p95 %s  p99 %s  max %s", latency_text(latency.m_P50).c_str(), latency_text(latency.m_P95).c_str(),
+                                latency_text(latency.m_P99).c_str(), latency_text(latency.m_Max).c_str());
+                }
             }
             ImGui::EndTooltip();
         }
@@ -3087,7 +3508,13 @@ bool BluePrintUI::File_Open(std::string path, string* error)
 {
     if (File_IsOpen())
     {
-        m_Document->Save();
+        // current document is written in background from its snapshot, document without path is not saved
+        if (!m_Document->m_Path.empty())
+        {
+            m_AutoSave.Save(*m_Document, m_Document->m_Path);
+            if (path == m_Document->m_Path)
+                m_AutoSave.Wait();
+        }
         ed::ClearSelection();
         m_Document->m_Blueprint.Clear();
     }
@@ -3495,7 +3922,7 @@ bool BluePrintUI::View_ShowFlow()
     if (!m_Document)
         return false;
 
-    m_Document->m_Blueprint.ShowFlow();
+    ShowFlow();
     
     return true;
 }
@@ -3674,8 +4101,8 @@ bool BluePrintUI::Blueprint_Next()
     auto result = m_Document->m_Blueprint.Next();
 
     ed::PushStyleVar(ed::StyleVar_FlowMarkerDistance, 30.0f);
-    ed::PushStyleVar(ed::StyleVar_FlowDuration, 1.0f);
-    m_Document->m_Blueprint.ShowFlow();
+    ed::PushStyleVar(ed::StyleVar_FlowDuration, FLOW_DURATION);
+    ShowFlow();
     ed::PopStyleVar(2);
 
     return true;
@@ -3688,8 +4115,8 @@ bool BluePrintUI::Blueprint_Current()
     auto result = m_Document->m_Blueprint.Current();
 
     ed::PushStyleVar(ed::StyleVar_FlowMarkerDistance, 30.0f);
-    ed::PushStyleVar(ed::StyleVar_FlowDuration, 1.0f);
-    m_Document->m_Blueprint.ShowFlow();
+    ed::PushStyleVar(ed::StyleVar_FlowDuration, FLOW_DURATION);
+    ShowFlow();
     ed::PopStyleVar(2);
 
     return true;
@@ -4123,6 +4550,7 @@ bool BluePrintUI::Blueprint_UpdateNode(ID_TYPE id)
     auto node = m_Document->m_Blueprint.FindNode(id);
     if (!node)
         return false;
+    node->MarkDirty();
     ed::SetNodeChanged(node->m_ID);
     ed::Update();
     return true;
@@ -5,6 +5,7 @@
 #include <inttypes.h>
 #include <UI.h>
 #include <Debug.h>
+#include <filesystem>
 
 namespace BluePrint
 {
@@ -35,12 +36,11 @@ std::string IDToHexString(const ID_TYPE i)
     return s.str();
 }
 
-ID_TYPE GetIDFromMap(ID_TYPE ID, std::map<ID_TYPE, ID_TYPE> MapID)
+ID_TYPE GetIDFromMap(ID_TYPE ID, const std::map<ID_TYPE, ID_TYPE>& MapID)
 {
     if (MapID.size() > 0)
     {
-        std::map<ID_TYPE, ID_TYPE>::iterator it;
-        it = MapID.find(ID);
+        auto it = MapID.find(ID);
         if (it == MapID.end())
             return 0;
         else
@@ -49,6 +49,18 @@ ID_TYPE GetIDFromMap(ID_TYPE ID, std::map<ID_TYPE, ID_TYPE> MapID)
     return ID;
 }
 
+bool GetFileStamp(const std::string& path, std::string& mtime, int64_t& size)
+{
+    std::error_code ec;
+    auto time = std::filesystem::last_write_time(path, ec);
+    if (ec) return false;
+    auto file_size = std::filesystem::file_size(path, ec);
+    if (ec) return false;
+    mtime = std::to_string(time.time_since_epoch().count());
+    size = (int64_t)file_size;
+    return true;
+}
+
 IconType PinTypeToIconType(PinType pinType)
 {
     switch (pinType)
@@ -0,0 +1,1564 @@
+#include <UI.h>
+#include <CommonNode/GroupNode.h>
+#include "bench_common.h"
+#include <getopt.h>
+#include <stdio.h>
+#include <filesystem>
+#include <thread>
+#include <chrono>
+#include <time.h>
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+#endif
+
+// Headless benchmark for BluePrint SDK, no application window is needed.
+//
+//   bench_blueprint [-p <plugin_dir> ...] [-s] [-j <result.json>]
+//
+//   -s   run suite only, -j writes suite results as json to track them across releases
+//
+// exit code is non zero when any check of the run fails (same/restored/lossless/saved/load_ok...)
+//
+// startup: time of loading every node plugin one by one against BluePrintUI::LoadPlugins,
+//          without and with plugin manifest. parallel path is measured first so the serial
+//          path gets warm dlopen cache, the reported speedup is a lower bound
+// custom_pin: load thousands of custom pins from json with hundreds of PinEx types registered
+// load: json against memory mapped binary blueprint
+// save: json DOM save against streaming writer, time and peak RSS growth (linux)
+// incremental: save after a single edit reuses cached records of clean nodes, graph of mixed node types
+// clone: json round trip against structural BP copy, both copies must save to same json
+// instance: 500 clips using same filter, fully loaded BP per clip against BPInstancePool,
+//           time and resident memory growth per instance (linux)
+// undo: cost per edit and json size of delta undo steps against full document state, undo
+//       everything back must give initial state, steps kept under memory limit
+// autosave: UI frame time while document is saved on UI thread and by DocumentAutoSave
+// group_drag: GroupNode pin scan while a group with hundreds of nodes is dragged, first scan
+//             exports pins, later frames see no change, rescan is a full scan after link edit
+// nested_run: run a chain where every node sits in groups nested 0/1/4/16 deep, flow and data
+//             cross all group levels between nodes, step cost must not grow with depth
+// import: repeated import of one exported group file, parsed every time against template cache
+// trace: run time with ExecutionTracer attached against plain run, size of written chrome trace
+// arena: load, close and run per step cost with nodes and pins in BP arena against the heap,
+//        cache misses per step (linux perf events)
+// pin_table: FindPinsLinkedTo on 50k pins against walk over pin objects, pin table, reverse link
+//            index and flat link rebuild after a link edit
+// link_index: link/unlink cost and FindPinsLinkedTo through reverse link index in a 10k pin graph,
+//             index must agree with m_LinkFrom of every pin
+// frame: UI frame time and fps against node count with every node drawn and with nodes out of view
+//        culled, zoomed to content with full nodes against plain rectangles
+// icon: pin icon draw time tessellated per call against stamped from icon cache, vertices must match
+// idle: cpu usage of an untouched editor rendered every tick against only when Frame() needs update
+// suite: chain, fan-out/fan-in, nested group, loop and mat pass-through graphs at several sizes,
+//        build/save/load/clone time, run time and cost per step
+
+using namespace BluePrint;
+
+// entry -> count x CountNode -> exit, linked by flow pins
+static bool BuildChain(BP& blueprint, int count)
+{
+    auto entry = blueprint.CreateNode("SystemEntryPointNode");
+    if (!entry)
+        return false;
+    Pin* prev = entry->GetOutputPins()[0];
+    for (int i = 0; i < count; i++)
+    {
+        auto node = blueprint.CreateNode("CountNode");
+        if (!node)
+            return false;
+        prev->LinkTo(*node->GetInputPins()[0]);
+        prev = node->GetOutputPins()[0];
+    }
+    auto exit = blueprint.CreateNode("SystemExitPointNode");
+    if (!exit)
+        return false;
+    prev->LinkTo(*exit->GetInputPins()[0]);
+    return true;
+}
+
+// entry -> count nodes of built-in types taken in turn -> exit, nodes with flow pins are chained,
+// arithmetic and const nodes stand on their own
+static bool BuildMixed(BP& blueprint, int count)
+{
+    static const char* types[] =
+    {
+        "CountNode", "FloatCountNode", "TimerNode", "ToStringNode", "ConstValueNode",
+        "ComparatorNode", "AddNode", "DateTimeNode", "FlipFlopNode", "CompareNode", "BranchNode",
+    };
+    auto entry = blueprint.CreateNode("SystemEntryPointNode");
+    if (!entry)
+        return false;
+    Pin* prev = entry->GetOutputPins()[0];
+    for (int i = 0; i < count; i++)
+    {
+        auto node = blueprint.CreateNode(types[i % (sizeof(types) / sizeof(types[0]))]);
+        if (!node)
+            return false;
+        auto input = node->GetAutoLinkInputFlowPin();
+        auto output = node->GetAutoLinkOutputFlowPin();
+        if (input && output)
+        {
+            prev->LinkTo(*input);
+            prev = output;
+        }
+    }
+    auto exit = blueprint.CreateNode("SystemExitPointNode");
+    if (!exit)
+        return false;
+    prev->LinkTo(*exit->GetInputPins()[0]);
+    return true;
+}
+
+// filter entry -> count x CountNode -> mat exit, entry mat is linked to exit, one float parameter.
+// flow goes Completed -> Enter so a run passes every node, returns filter entry
+static Node* BuildFilter(BP& blueprint, int count)
+{
+    auto entry = blueprint.CreateNode("FilterEntryPointNode");
+    auto exit = blueprint.CreateNode("MatExitPointNode");
+    if (!entry || !exit)
+        return nullptr;
+    entry->InsertOutputPin(PinType::Float, "Strength");
+    Pin* prev = entry->GetOutputPins()[0];
+    for (int i = 0; i < count; i++)
+    {
+        auto node = blueprint.CreateNode("CountNode");
+        if (!node)
+            return nullptr;
+        prev->LinkTo(*node->GetInputPins()[0]);
+        prev = node->GetOutputPins()[2];
+    }
+    prev->LinkTo(*exit->GetInputPins()[0]);
+    exit->GetInputPins()[1]->LinkTo(*entry->GetOutputPins()[1]);
+    return entry;
+}
+
+static void BenchStartup(const std::vector<std::string>& plugin_path)
+{
+    int plugin_count = BluePrintUI::CheckPlugins(plugin_path);
+    if (plugin_count <= 0)
+    {
+        fprintf(stderr, "startup: no plugin found\n");
+        return;
+    }
+
+    // parallel, manifest is removed first so every plugin is opened
+    int index = 0;
+    float percentage = 0;
+    std::string message;
+    std::string manifest_path = (std::filesystem::temp_directory_path() / "bench_blueprint_plugins.json").string();
+    std::filesystem::remove(manifest_path);
+    auto start_time = ImGui::get_current_time_usec();
+    BluePrintUI::LoadPlugins(plugin_path, index, message, percentage, plugin_count, manifest_path);
+    auto parallel_time = ImGui::get_current_time_usec() - start_time;
+
+    // manifest, plugins are registered from cache and opened at first Create
+    start_time = ImGui::get_current_time_usec();
+    BluePrintUI::LoadPlugins(plugin_path, index, message, percentage, plugin_count, manifest_path);
+    auto manifest_time = ImGui::get_current_time_usec() - start_time;
+
+    // serial
+    NodeRegistry registry;
+    int node_count = 0;
+    start_time = ImGui::get_current_time_usec();
+    for (auto& path : plugin_path)
+    {
+        std::vector<std::string> plugins, plugin_names;
+        std::vector<std::string> node_filter = {"node"};
+        if (DIR_Iterate(path, plugins, plugin_names, node_filter, false) != 0)
+            continue;
+        for (auto& node_path : plugins)
+        {
+            if (registry.RegisterNodeType(node_path) != 0)
+                node_count ++;
+        }
+    }
+    auto serial_time = ImGui::get_current_time_usec() - start_time;
+
+    printf("startup: plugins=%d nodes=%d serial=%.3fms parallel=%.3fms manifest=%.3fms speedup=%.2fx/%.2fx\n",
+            plugin_count, node_count, serial_time / 1000.0, parallel_time / 1000.0, manifest_time / 1000.0,
+            parallel_time > 0 ? (double)serial_time / (double)parallel_time : 0.0,
+            manifest_time > 0 ? (double)serial_time / (double)manifest_time : 0.0);
+    std::filesystem::remove(manifest_path);
+}
+
+// custom pin: create custom pins from json with many PinEx types registered
+class BenchPinEx : public PinEx
+{
+public:
+    const PinTypeEx& GetTypeEx() const override { static PinTypeEx type("BenchPinEx"); return type; }
+    void SetValuePtr(void* valuePtr, const std::type_info& typeInfo) override {}
+};
+
+static void BenchCustomPin(int type_count, int pin_count)
+{
+    auto pinexRegistry = BP::GetPinExRegistry();
+    static std::vector<std::unique_ptr<PinExModuleInfo>> type_infos;
+    for (int i = 0; i < type_count; i++)
+    {
+        type_infos.emplace_back(new PinExModuleInfo { PinTypeEx("BenchPinEx_" + std::to_string(i)), 0, []() -> PinEx* { return new BenchPinEx(); } });
+        pinexRegistry->RegisterPinEx(type_infos.back().get());
+    }
+
+    BP blueprint;
+    auto node = blueprint.CreateNode("DummyNode");
+    if (!node)
+    {
+        BenchFail("custom_pin", "create node");
+        return;
+    }
+    std::vector<imgui_json::value> pin_values(pin_count);
+    for (int i = 0; i < pin_count; i++)
+    {
+        pin_values[i]["type"] = PinTypeToString(PinType::Custom);
+        pin_values[i]["id"] = imgui_json::number(i + 1000);
+        pin_values[i]["extype_name"] = "BenchPinEx_" + std::to_string(i % type_count);
+    }
+
+    std::vector<std::unique_ptr<CustomPin>> pins;
+    pins.reserve(pin_count);
+    int failed = 0;
+    auto start_time = ImGui::get_current_time_usec();
+    for (auto& pin_value : pin_values)
+    {
+        pins.emplace_back(new CustomPin(node, "BenchPinEx_0"));
+        if (!pins.back()->Load(pin_value))
+            failed ++;
+    }
+    auto load_time = ImGui::get_current_time_usec() - start_time;
+    pins.clear();
+
+    Passed(failed == 0);
+    printf("custom_pin: types=%d pins=%d failed=%d load=%.3fms per_pin=%.3fus\n",
+            type_count, pin_count, failed, load_time / 1000.0, (double)load_time / (double)pin_count);
+}
+
+// load: load same blueprint from json and from binary file, check json -> binary -> json is lossless
+static void BenchLoad(int count)
+{
+    auto temp_path = std::filesystem::temp_directory_path();
+    std::string json_path = (temp_path / "bench_blueprint_load.json").string();
+    std::string binary_path = (temp_path / "bench_blueprint_load.bpb").string();
+    {
+        BP blueprint;
+        if (!BuildChain(blueprint, count))
+        {
+            BenchFail("load", "build blueprint");
+            return;
+        }
+        blueprint.Save(json_path);
+        blueprint.SaveBinary(binary_path);
+    }
+
+    BP blueprint;
+    int json_ret = BP_ERR_NONE, binary_ret = BP_ERR_NONE;
+    auto ab = MeasureAB([&]() { json_ret = blueprint.Load(json_path); },
+                        [&]() { binary_ret = blueprint.LoadBinary(binary_path); });
+
+    bool lossless = false;
+    auto json_value = imgui_json::value::load(json_path);
+    if (json_value.second)
+    {
+        BinaryWriter writer;
+        imgui_json::value value;
+        if (BP::JsonToBinary(json_value.first, writer) == BP_ERR_NONE)
+        {
+            BinaryReader reader(writer.Data(), writer.Size());
+            lossless = BP::BinaryToJson(reader, value) == BP_ERR_NONE && value.dump() == json_value.first.dump();
+        }
+    }
+
+    printf("load: nodes=%d json=%.3fms(%s) binary=%.3fms(%s) speedup=%.2fx size=%ju/%ju lossless=%s\n",
+            count + 2, ab.m_TimeA / 1000.0, Passed(json_ret == BP_ERR_NONE) ? "ok" : "failed",
+            ab.m_TimeB / 1000.0, Passed(binary_ret == BP_ERR_NONE) ? "ok" : "failed", ab.Speedup(),
+            (uintmax_t)std::filesystem::file_size(json_path), (uintmax_t)std::filesystem::file_size(binary_path),
+            Check(lossless));
+    std::filesystem::remove(json_path);
+    std::filesystem::remove(binary_path);
+}
+
+// peak resident memory in KB, reset is supported by linux only
+static void ResetPeakRSS()
+{
+#if defined(__linux__)
+    if (auto file = fopen("/proc/self/clear_refs", "w"))
+    {
+        fputs("5", file);
+        fclose(file);
+    }
+#endif
+}
+
+static long PeakRSS()
+{
+    long peak = 0;
+#if defined(__linux__)
+    if (auto file = fopen("/proc/self/status", "r"))
+    {
+        char line[256];
+        while (fgets(line, sizeof(line), file))
+        {
+            if (sscanf(line, "VmHWM: %ld kB", &peak) == 1)
+                break;
+        }
+        fclose(file);
+    }
+#endif
+    return peak;
+}
+
+// current resident memory in KB
+static long CurrentRSS()
+{
+    long rss = 0;
+#if defined(__linux__)
+    if (auto file = fopen("/proc/self/status", "r"))
+    {
+        char line[256];
+        while (fgets(line, sizeof(line), file))
+        {
+            if (sscanf(line, "VmRSS: %ld kB", &rss) == 1)
+                break;
+        }
+        fclose(file);
+    }
+#endif
+    return rss;
+}
+
+// hardware cache misses of calling thread, linux only, -1 if perf events are not available
+#if defined(__linux__)
+static int StartCacheMisses()
+{
+    perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.config = PERF_COUNT_HW_CACHE_MISSES;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    int fd = (int)syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+    if (fd >= 0)
+    {
+        ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+        ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+    }
+    return fd;
+}
+
+static long long StopCacheMisses(int fd)
+{
+    if (fd < 0)
+        return -1;
+    ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+    long long count = -1;
+    if (read(fd, &count, sizeof(count)) != sizeof(count))
+        count = -1;
+    close(fd);
+    return count;
+}
+#else
+static int StartCacheMisses() { return -1; }
+static long long StopCacheMisses(int fd) { return -1; }
+#endif
+
+// save: DOM save against streaming writer
+static void BenchSave(int count)
+{
+    std::string json_path = (std::filesystem::temp_directory_path() / "bench_blueprint_save.json").string();
+    BP blueprint;
+    if (!BuildChain(blueprint, count))
+    {
+        BenchFail("save", "build blueprint");
+        return;
+    }
+
+    ResetPeakRSS();
+    auto base_rss = PeakRSS();
+    blueprint.MarkDirty();
+    auto start_time = ImGui::get_current_time_usec();
+    blueprint.Save(json_path);
+    auto stream_time = ImGui::get_current_time_usec() - start_time;
+    auto stream_rss = PeakRSS() - base_rss;
+
+    blueprint.MarkDirty();
+    ResetPeakRSS();
+    base_rss = PeakRSS();
+    start_time = ImGui::get_current_time_usec();
+    {
+        imgui_json::value value;
+        blueprint.Save(value);
+        value.save(json_path, 4);
+    }
+    auto dom_time = ImGui::get_current_time_usec() - start_time;
+    auto dom_rss = PeakRSS() - base_rss;
+
+    printf("save: nodes=%d dom=%.3fms/%ldKB stream=%.3fms/%ldKB\n",
+            count + 2, dom_time / 1000.0, dom_rss, stream_time / 1000.0, stream_rss);
+    std::filesystem::remove(json_path);
+}
+
+// incremental: full save against save after renaming one node of a mixed graph, result must match full save
+static void BenchIncrementalSave(int count)
+{
+    BP blueprint;
+    if (!BuildMixed(blueprint, count))
+    {
+        BenchFail("incremental", "build blueprint");
+        return;
+    }
+
+    // every full save starts with all records dropped, every incremental one follows a new edit
+    auto nodes = blueprint.GetNodes();
+    imgui_json::value incremental_value;
+    int edits = 0;
+    auto ab = MeasureAB([&]() { blueprint.MarkDirty(); },
+                        [&]() { imgui_json::value value; blueprint.Save(value); },
+                        [&]() { nodes[2 + count / 2]->SetName("edited " + std::to_string(++edits)); },
+                        [&]() { blueprint.Save(incremental_value); });
+
+    imgui_json::value full_value;
+    blueprint.MarkDirty();
+    blueprint.Save(full_value);
+    bool same = incremental_value.dump() == full_value.dump();
+
+    printf("incremental: nodes=%d full=%.3fms one_edit=%.3fms speedup=%.2fx same=%s\n",
+            count + 2, ab.m_TimeA / 1000.0, ab.m_TimeB / 1000.0, ab.Speedup(), Check(same));
+}
+
+// clone: Save()/Load() round trip against BP copy constructor
+static void BenchClone(int count)
+{
+    BP blueprint;
+    if (!BuildChain(blueprint, count))
+    {
+        BenchFail("clone", "build blueprint");
+        return;
+    }
+
+    BP json_copy;
+    std::unique_ptr<BP> clone_copy;
+    auto ab = MeasureAB([&]() { imgui_json::value value; blueprint.Save(value); json_copy.Load(value); },
+                        [&]() { clone_copy.reset(new BP(blueprint)); });
+
+    imgui_json::value json_value, clone_value;
+    json_copy.Save(json_value);
+    clone_copy->Save(clone_value);
+    bool same = json_value.dump() == clone_value.dump();
+
+    printf("clone: nodes=%d json=%.3fms clone=%.3fms speedup=%.2fx same=%s\n",
+            count + 2, ab.m_TimeA / 1000.0, ab.m_TimeB / 1000.0, ab.Speedup(), Check(same));
+}
+
+// instance: every clip loads own BP against instances taken from pool
+static void BenchInstancePool(int count)
+{
+    imgui_json::value value;
+    {
+        BP blueprint;
+        if (!BuildFilter(blueprint, 32))
+        {
+            BenchFail("instance", "build filter");
+            return;
+        }
+        blueprint.Save(value);
+    }
+
+    // pool is measured first so its instances can't reuse memory freed by loaded blueprints
+    BPInstancePool pool;
+    if (pool.Load(value) != BP_ERR_NONE)
+    {
+        BenchFail("instance", "load template");
+        return;
+    }
+    std::vector<BP*> instances;
+    auto base_rss = CurrentRSS();
+    auto start_time = ImGui::get_current_time_usec();
+    for (int i = 0; i < count; i++)
+        instances.push_back(pool.Acquire());
+    auto create_time = ImGui::get_current_time_usec() - start_time;
+    auto pool_rss = CurrentRSS() - base_rss;
+
+    // pin value and CountNode setting are changed by clip, both go back to template on release
+    auto accumulate = [](BP* instance)
+    {
+        imgui_json::value record;
+        instance->GetNodes()[1]->Save(record);
+        return record.contains("accumulate") && record["accumulate"].get<imgui_json::boolean>();
+    };
+    for (auto instance : instances)
+    {
+        auto entry = instance->GetNodes()[0];
+        entry->GetOutputPins()[2]->SetValue(0.5f);
+        imgui_json::value record;
+        instance->GetNodes()[1]->Save(record);
+        record["accumulate"] = imgui_json::boolean(true);
+        instance->GetNodes()[1]->Load(record);
+        pool.Release(instance);
+    }
+    instances.clear();
+    start_time = ImGui::get_current_time_usec();
+    for (int i = 0; i < count; i++)
+        instances.push_back(pool.Acquire());
+    auto reuse_time = ImGui::get_current_time_usec() - start_time;
+    bool restored = std::all_of(instances.begin(), instances.end(), [&](BP* instance)
+    {
+        return instance->GetNodes()[0]->GetOutputPins()[2]->GetValue().As<float>() == 0.f && !accumulate(instance);
+    });
+    for (auto instance : instances)
+        pool.Release(instance);
+
+    std::vector<std::unique_ptr<BP>> blueprints;
+    base_rss = CurrentRSS();
+    start_time = ImGui::get_current_time_usec();
+    for (int i = 0; i < count; i++)
+    {
+        blueprints.emplace_back(new BP());
+        blueprints.back()->Load(value);
+    }
+    auto load_time = ImGui::get_current_time_usec() - start_time;
+    auto load_rss = CurrentRSS() - base_rss;
+
+    printf("instance: clips=%d load=%.3fus/%.1fKB pool_create=%.3fus/%.1fKB pool_reuse=%.3fus restored=%s\n",
+            count, (double)load_time / count, (double)load_rss / count,
+            (double)create_time / count, (double)pool_rss / count,
+            (double)reuse_time / count, Check(restored));
+}
+
+// undo: rename one node per transaction as editor would do, on mixed graph without CountNode edits,
+// then same edits while autosave holds state snapshot
+static void BenchUndo(int count, int edits)
+{
+    Document document;
+    if (!BuildMixed(document.m_Blueprint, count))
+    {
+        BenchFail("undo", "build blueprint");
+        return;
+    }
+    document.EditDocumentState() = document.BuildDocumentState();
+    auto initial_state = document.GetDocumentState().Serialize().dump();
+
+    std::vector<Node*> targets;
+    for (auto node : document.m_Blueprint.GetNodes())
+    {
+        if (node->GetTypeInfo().m_Name != "CountNode")
+            targets.push_back(node);
+    }
+    auto edit = [&](int i)
+    {
+        auto transaction = document.BeginUndoTransaction("Rename");
+        targets[i % targets.size()]->SetName("edit " + std::to_string(i));
+        transaction->AddAction("Set Name");
+    };
+
+    auto start_time = ImGui::get_current_time_usec();
+    for (int i = 0; i < edits; i++)
+        edit(i);
+    auto edit_time = ImGui::get_current_time_usec() - start_time;
+
+    size_t delta_size = 0;
+    for (auto& state : document.m_Undo)
+        delta_size += state.m_Delta.dump().size();
+    size_t steps = document.m_Undo.size();
+    size_t full_size = initial_state.size();
+
+    while (document.Undo()) {}
+    bool restored = document.GetDocumentState().Serialize().dump() == initial_state;
+
+    // held snapshot must stay as it was taken, edits go on without copying state
+    document.ClearUndo();
+    auto snapshot = document.GetStateSnapshot();
+    start_time = ImGui::get_current_time_usec();
+    for (int i = 0; i < edits; i++)
+        edit(i);
+    auto held_time = ImGui::get_current_time_usec() - start_time;
+    bool snapshot_kept = snapshot->Serialize().dump() == initial_state;
+    snapshot.reset();
+    while (document.Undo()) {}
+    restored = restored && snapshot_kept && document.GetDocumentState().Serialize().dump() == initial_state;
+
+    document.ClearUndo();
+    document.m_UndoMemoryLimit = 1024 * 1024;
+    for (int i = 0; i < edits; i++)
+        edit(i);
+
+    printf("undo: nodes=%d edits=%d per_edit=%.3fms per_edit_held=%.3fms step=%zuB full_state=%zuB restored=%s limit=1MB kept=%zu/%d\n",
+            count + 2, edits, edit_time / 1000.0 / edits, held_time / 1000.0 / edits, steps ? delta_size / steps : 0, full_size,
+            Check(restored), document.m_Undo.size(), edits);
+}
+
+// busy frame of given length, stands for UI work between saves
+static void SimulateFrame(int64_t frame_us)
+{
+    auto start_time = ImGui::get_current_time_usec();
+    while (ImGui::get_current_time_usec() - start_time < frame_us) {}
+}
+
+// autosave: same document saved in the middle of simulated frames, synchronous and in background
+static void BenchAutoSave(int count, int frames)
+{
+    std::string path = (std::filesystem::temp_directory_path() / "bench_blueprint_autosave.json").string();
+    Document document;
+    if (!BuildChain(document.m_Blueprint, count))
+    {
+        BenchFail("autosave", "build blueprint");
+        return;
+    }
+    document.EditDocumentState() = document.BuildDocumentState();
+    const int64_t frame_us = 4000;
+
+    int64_t sync_max = 0;
+    for (int i = 0; i < frames; i++)
+    {
+        auto start_time = ImGui::get_current_time_usec();
+        if (i == frames / 2)
+            document.Save(path);
+        SimulateFrame(frame_us);
+        sync_max = std::max(sync_max, ImGui::get_current_time_usec() - start_time);
+    }
+
+    DocumentAutoSave autosave;
+    int64_t async_max = 0, handoff_time = 0;
+    for (int i = 0; i < frames; i++)
+    {
+        auto start_time = ImGui::get_current_time_usec();
+        if (i == frames / 2)
+        {
+            autosave.Save(document, path);
+            handoff_time = ImGui::get_current_time_usec() - start_time;
+        }
+        SimulateFrame(frame_us);
+        async_max = std::max(async_max, ImGui::get_current_time_usec() - start_time);
+    }
+    autosave.Wait();
+    bool saved = autosave.LastSaveSucceeded() && imgui_json::value::load(path).second;
+    autosave.Stop();
+
+    printf("autosave: nodes=%d frame=%.3fms sync_max_frame=%.3fms async_max_frame=%.3fms handoff=%.3fus saved=%s\n",
+            count + 2, frame_us / 1000.0, sync_max / 1000.0, async_max / 1000.0, (double)handoff_time, Check(saved));
+    std::filesystem::remove(path);
+}
+
+// group_drag: entry -> group of count x CountNode -> exit, only first and last flow pins are exported
+static void BenchGroupDrag(int count, int frames)
+{
+    BP blueprint;
+    auto entry = blueprint.CreateNode("SystemEntryPointNode");
+    auto group = static_cast<GroupNode*>(blueprint.CreateNode("GroupNode"));
+    auto exit = blueprint.CreateNode("SystemExitPointNode");
+    if (!entry || !group || !exit)
+    {
+        BenchFail("group_drag", "build blueprint");
+        return;
+    }
+    Pin* prev = entry->GetOutputPins()[0];
+    for (int i = 0; i < count; i++)
+    {
+        auto node = blueprint.CreateNode("CountNode");
+        prev->LinkTo(*node->GetInputPins()[0]);
+        prev = node->GetOutputPins()[0];
+        // membership is decided by node editor bounds, which a headless editor has none of
+        node->m_GroupID = group->m_ID;
+        group->m_GroupNodes.push_back(node);
+    }
+    prev->LinkTo(*exit->GetInputPins()[0]);
+    group->RebuildIndex();
+
+    auto& context = blueprint.GetContext();
+    auto start_time = ImGui::get_current_time_usec();
+    group->OnDragStart(context);
+    auto first_time = ImGui::get_current_time_usec() - start_time;
+
+    int64_t total_time = 0, max_time = 0;
+    for (int i = 0; i < frames; i++)
+    {
+        start_time = ImGui::get_current_time_usec();
+        group->Update();
+        auto frame_time = ImGui::get_current_time_usec() - start_time;
+        total_time += frame_time;
+        max_time = std::max(max_time, frame_time);
+    }
+
+    blueprint.TouchLinks();
+    start_time = ImGui::get_current_time_usec();
+    group->OnDragEnd(context);
+    auto rescan_time = ImGui::get_current_time_usec() - start_time;
+
+    printf("group_drag: nodes=%d first_scan=%.3fms frame_avg=%.3fus frame_max=%.3fus rescan=%.3fms bridge_in=%zu bridge_out=%zu\n",
+            count, first_time / 1000.0, (double)total_time / frames, (double)max_time, rescan_time / 1000.0,
+            group->m_InputBridgePins.size(), group->m_OutputBridgePins.size());
+}
+
+// export pin of a member through nested groups, groups are ordered outermost first.
+// pins are linked as GroupNode::ScanAllPins() does, returns bridge pin of outermost group
+static Pin* ExportInput(const std::vector<GroupNode*>& groups, Pin* pin)
+{
+    for (auto it = groups.rbegin(); it != groups.rend(); ++it)
+    {
+        Pin *bridge_pin = nullptr, *shadow_pin = nullptr;
+        (*it)->AddInputPin(pin, &bridge_pin, &shadow_pin);
+        if (pin->GetType() == PinType::Flow)
+        {
+            bridge_pin->LinkTo(*shadow_pin);
+            shadow_pin->LinkTo(*pin);
+        }
+        else
+        {
+            pin->LinkTo(*shadow_pin);
+            shadow_pin->LinkTo(*bridge_pin);
+        }
+        pin = bridge_pin;
+    }
+    return pin;
+}
+
+static Pin* ExportOutput(const std::vector<GroupNode*>& groups, Pin* pin)
+{
+    for (auto it = groups.rbegin(); it != groups.rend(); ++it)
+    {
+        Pin *bridge_pin = nullptr, *shadow_pin = nullptr;
+        (*it)->AddOutputPin(pin, &bridge_pin, &shadow_pin);
+        if (pin->GetType() == PinType::Flow)
+        {
+            pin->LinkTo(*shadow_pin);
+            shadow_pin->LinkTo(*bridge_pin);
+        }
+        else
+        {
+            bridge_pin->LinkTo(*shadow_pin);
+            shadow_pin->LinkTo(*pin);
+        }
+        pin = bridge_pin;
+    }
+    return pin;
+}
+
+// entry -> count x CountNode -> exit, each CountNode inside depth nested groups,
+// flow goes Completed -> Enter and N of every node reads Counter of previous one.
+// flow_outs gets every pin which starts a transition between nodes
+static Node* BuildNestedChain(BP& blueprint, int count, int depth, std::vector<Pin*>& flow_outs)
+{
+    auto entry = blueprint.CreateNode("SystemEntryPointNode");
+    auto exit = blueprint.CreateNode("SystemExitPointNode");
+    if (!entry || !exit)
+        return nullptr;
+    Pin* prev_flow = entry->GetOutputPins()[0];
+    Pin* prev_data = nullptr;
+    for (int i = 0; i < count; i++)
+    {
+        auto node = blueprint.CreateNode("CountNode");
+        if (!node)
+            return nullptr;
+        std::vector<GroupNode*> groups;
+        for (int d = 0; d < depth; d++)
+        {
+            auto group = static_cast<GroupNode*>(blueprint.CreateNode("GroupNode"));
+            // membership is decided by node editor bounds, which a headless editor has none of
+            if (!groups.empty()) group->m_GroupID = groups.back()->m_ID;
+            groups.push_back(group);
+        }
+        if (!groups.empty()) node->m_GroupID = groups.back()->m_ID;
+
+        auto enter = ExportInput(groups, node->GetInputPins()[0]);
+        auto n = ExportInput(groups, node->GetInputPins()[1]);
+        prev_flow->LinkTo(*enter);
+        flow_outs.push_back(prev_flow);
+        if (prev_data) n->LinkTo(*prev_data);
+        prev_flow = ExportOutput(groups, node->GetOutputPins()[2]);
+        prev_data = ExportOutput(groups, node->GetOutputPins()[1]);
+    }
+    prev_flow->LinkTo(*exit->GetInputPins()[0]);
+    flow_outs.push_back(prev_flow);
+    return entry;
+}
+
+// nested_run: run a nested chain, step cost against old per hop walk and flat lookup
+static void BenchNestedRun(int count, int depth, int runs)
+{
+    BP blueprint;
+    std::vector<Pin*> flow_outs;
+    auto entry = BuildNestedChain(blueprint, count, depth, flow_outs);
+    if (!entry)
+    {
+        BenchFail("nested_run", "build blueprint");
+        return;
+    }
+
+    // first run builds the flat link view
+    blueprint.Run(*entry);
+    auto steps = blueprint.GetContext().StepCount();
+
+    auto start_time = ImGui::get_current_time_usec();
+    for (int i = 0; i < runs; i++)
+        blueprint.Run(*entry);
+    auto run_time = ImGui::get_current_time_usec() - start_time;
+
+    // what every flow transition paid before, one pin lookup per bridge/shadow hop
+    size_t hops = 0;
+    start_time = ImGui::get_current_time_usec();
+    for (int i = 0; i < runs; i++)
+    {
+        for (auto pin : flow_outs)
+        {
+            auto link = pin->GetLink(&blueprint);
+            while (link && link->IsMappedPin())
+            {
+                link = link->GetLink(&blueprint);
+                hops++;
+            }
+        }
+    }
+    auto walk_time = ImGui::get_current_time_usec() - start_time;
+
+    size_t resolved = 0;
+    start_time = ImGui::get_current_time_usec();
+    for (int i = 0; i < runs; i++)
+    {
+        for (auto pin : flow_outs)
+            resolved += blueprint.ResolveLink(*pin) ? 1 : 0;
+    }
+    auto flat_time = ImGui::get_current_time_usec() - start_time;
+
+    double transitions = (double)runs * flow_outs.size();
+    printf("nested_run: nodes=%d depth=%d steps=%u step=%.3fus walk=%.3fus(%zu hops) flat=%.3fus resolved=%s\n",
+            count, depth, steps, (double)run_time / ((double)runs * std::max(steps, 1u)),
+            walk_time / transitions, hops / runs, flat_time / transitions,
+            Check(resolved == (size_t)transitions));
+}
+
+// import: same exported group dropped into a graph again and again, file parsed on every import
+// against group template cache, both ways must give same number of nodes
+static void BenchImport(int count, int imports)
+{
+    auto path = (std::filesystem::temp_directory_path() / "bench_blueprint_group.json").string();
+    {
+        BP blueprint;
+        auto group = static_cast<GroupNode*>(blueprint.CreateNode("GroupNode"));
+        if (!group)
+        {
+            BenchFail("import", "build blueprint");
+            return;
+        }
+        for (int i = 0; i < count; i++)
+        {
+            auto node = blueprint.CreateNode("CountNode");
+            // membership is decided by node editor bounds, which a headless editor has none of
+            node->m_GroupID = group->m_ID;
+            group->m_GroupNodes.push_back(node);
+        }
+        group->RebuildIndex();
+        group->SaveGroup(path);
+    }
+
+    BP parse_blueprint, cached_blueprint;
+    bool imported = true;
+    auto ab = MeasureAB([&]()
+    {
+        for (int i = 0; i < imports && imported; i++)
+        {
+            auto loadResult = imgui_json::value::load(path);
+            imported = loadResult.second && parse_blueprint.Import(loadResult.first, ImVec2(0, 0)) == BP_ERR_NONE;
+        }
+    },
+    [&]()
+    {
+        for (int i = 0; i < imports && imported; i++)
+            imported = cached_blueprint.Import(path, ImVec2(0, 0)) == BP_ERR_NONE;
+    });
+    std::filesystem::remove(path);
+    if (!imported)
+    {
+        BenchFail("import", "import group");
+        return;
+    }
+
+    bool same = parse_blueprint.GetNodes().size() == cached_blueprint.GetNodes().size();
+    printf("import: nodes=%d imports=%d parse=%.3fms cached=%.3fms speedup=%.2fx same=%s\n",
+            count + 1, imports, ab.m_TimeA / 1000.0 / imports, ab.m_TimeB / 1000.0 / imports,
+            ab.Speedup(), Check(same));
+}
+
+// trace: run time of a nested chain without and with ExecutionTracer attached, trace is written once
+static void BenchTrace(int count, int runs)
+{
+    BP blueprint;
+    std::vector<Pin*> flow_outs;
+    auto entry = BuildNestedChain(blueprint, count, 2, flow_outs);
+    if (!entry)
+    {
+        BenchFail("trace", "build blueprint");
+        return;
+    }
+    blueprint.Run(*entry);
+
+    ExecutionTracer tracer;
+    auto run = [&]()
+    {
+        for (int i = 0; i < runs; i++)
+            blueprint.Run(*entry);
+    };
+    auto ab = MeasureAB([&]() { tracer.Detach(); }, run, [&]() { tracer.Attach(&blueprint); }, run);
+    tracer.Detach();
+    auto plain_time = ab.m_TimeA, trace_time = ab.m_TimeB;
+
+    auto path = (std::filesystem::temp_directory_path() / "bench_blueprint_trace.json").string();
+    auto start_time = ImGui::get_current_time_usec();
+    bool written = tracer.Write(path, &blueprint);
+    auto write_time = ImGui::get_current_time_usec() - start_time;
+    auto size = written ? (int64_t)std::filesystem::file_size(path) : 0;
+    std::filesystem::remove(path);
+
+    printf("trace: nodes=%d runs=%d plain=%.3fms traced=%.3fms overhead=%.2f%% events=%zu write=%.3fms size=%" PRId64 "KB written=%s\n",
+            count, runs, plain_time / 1000.0, trace_time / 1000.0,
+            plain_time > 0 ? (double)(trace_time - plain_time) * 100.0 / (double)plain_time : 0.0,
+            tracer.EventCount(), write_time / 1000.0, size / 1024, Check(written));
+}
+
+// arena: load, run and close with nodes and pins in BP arena against one heap allocation each
+static void BenchArena(int count, int loads, int runs)
+{
+    imgui_json::value value;
+    {
+        BP blueprint;
+        std::vector<Pin*> flow_outs;
+        if (!BuildNestedChain(blueprint, count, 0, flow_outs))
+        {
+            BenchFail("arena", "build blueprint");
+            return;
+        }
+        blueprint.Save(value);
+    }
+
+    for (auto enable : { false, true })
+    {
+        BPArena::SetEnabled(enable);
+        int64_t load_time = 0, clear_time = 0, run_time = 0;
+        long long misses = 0;
+        uint32_t steps = 0;
+        for (int i = 0; i < loads; i++)
+        {
+            // holes between other allocations, as in a long editor session, scatter heap allocated nodes
+            std::vector<std::unique_ptr<char[]>> noise(count * 4);
+            for (size_t j = 0; j < noise.size(); j++)
+                noise[j].reset(new char[32 + (j % 7) * 48]);
+            for (size_t j = 0; j < noise.size(); j += 2)
+                noise[j].reset();
+
+            BP blueprint;
+            auto start_time = ImGui::get_current_time_usec();
+            if (blueprint.Load(value) != BP_ERR_NONE)
+            {
+                BenchFail("arena", "load");
+                BPArena::SetEnabled(true);
+                return;
+            }
+            load_time += ImGui::get_current_time_usec() - start_time;
+
+            Node* entry = nullptr;
+            for (auto node : blueprint.GetNodes())
+                if (node->GetTypeInfo().m_NodeTypeName == "SystemEntryPointNode")
+                    entry = node;
+            if (entry)
+            {
+                blueprint.Run(*entry);
+                steps = blueprint.GetContext().StepCount();
+                auto fd = StartCacheMisses();
+                start_time = ImGui::get_current_time_usec();
+                for (int j = 0; j < runs; j++)
+                    blueprint.Run(*entry);
+                run_time += ImGui::get_current_time_usec() - start_time;
+                auto miss = StopCacheMisses(fd);
+                misses = (miss < 0 || misses < 0) ? -1 : misses + miss;
+            }
+
+            start_time = ImGui::get_current_time_usec();
+            blueprint.Clear();
+            clear_time += ImGui::get_current_time_usec() - start_time;
+        }
+
+        auto total_steps = (double)std::max(steps, 1u) * runs * loads;
+        printf("arena: %s nodes=%d load=%.3fms close=%.3fms step=%.3fus misses_per_step=",
+                enable ? "arena" : "heap ", count, load_time / 1000.0 / loads, clear_time / 1000.0 / loads,
+                run_time / total_steps);
+        if (misses >= 0)
+            printf("%.2f\n", misses / total_steps);
+        else
+            printf("n/a\n");
+    }
+    BPArena::SetEnabled(true);
+}
+
+// pin_table: FindPinsLinkedTo against walk over Pin objects, pin table and index rebuild after a link edit
+static void BenchPinTable(int pin_count, int queries)
+{
+    BP blueprint;
+    std::vector<Pin*> flow_outs;
+    // CountNode has 6 pins
+    auto entry = BuildNestedChain(blueprint, pin_count / 6, 0, flow_outs);
+    if (!entry)
+    {
+        BenchFail("pin_table", "build blueprint");
+        return;
+    }
+    auto pins = blueprint.GetPins();
+    std::vector<const Pin*> targets;
+    for (int i = 0; i < queries; i++)
+        targets.push_back(pins[(size_t)i * 7919 % pins.size()]);
+
+    // what FindPinsLinkedTo did before, every pin object is visited
+    size_t walk_found = 0;
+    auto start_time = ImGui::get_current_time_usec();
+    for (auto target : targets)
+    {
+        for (auto p : blueprint.GetPins())
+        {
+            auto link = p->GetLink(&blueprint);
+            if (link && link->m_ID == target->m_ID)
+                walk_found++;
+        }
+    }
+    auto walk_time = ImGui::get_current_time_usec() - start_time;
+
+    blueprint.TouchLinks();
+    start_time = ImGui::get_current_time_usec();
+    size_t table_found = blueprint.FindPinsLinkedTo(*targets[0]).size();
+    auto rebuild_time = ImGui::get_current_time_usec() - start_time;
+    table_found = 0;
+    start_time = ImGui::get_current_time_usec();
+    for (auto target : targets)
+        table_found += blueprint.FindPinsLinkedTo(*target).size();
+    auto table_time = ImGui::get_current_time_usec() - start_time;
+
+    // flat link view is built from table too
+    blueprint.TouchLinks();
+    start_time = ImGui::get_current_time_usec();
+    blueprint.ResolveLink(*flow_outs.back());
+    auto flat_time = ImGui::get_current_time_usec() - start_time;
+
+    printf("pin_table: pins=%zu queries=%d walk=%.3fus query=%.3fus per query, rebuild=%.3fms flat_links=%.3fms match=%s\n",
+            pins.size(), queries, (double)walk_time / queries, (double)table_time / queries,
+            rebuild_time / 1000.0, flat_time / 1000.0, Check(walk_found == table_found));
+}
+
+// link_index: link and unlink in a 10k pin graph, FindPinsLinkedTo through reverse link index
+static void BenchLinkIndex(int pin_count, int ops)
+{
+    BP blueprint;
+    std::vector<Pin*> flow_outs;
+    std::vector<Node*> nodes;
+    int node_count = pin_count / 6;
+    if (!BuildNestedChain(blueprint, node_count, 0, flow_outs))
+    {
+        BenchFail("link_index", "build blueprint");
+        return;
+    }
+    for (auto node : blueprint.GetNodes())
+        if (node->GetTypeInfo().m_NodeTypeName == "CountNode")
+            nodes.push_back(node);
+
+    // N of one node is moved to Counter of another one, every link is an unlink plus a link
+    auto start_time = ImGui::get_current_time_usec();
+    for (int i = 0; i < ops; i++)
+    {
+        auto receiver = nodes[(size_t)i * 7919 % nodes.size()]->GetInputPins()[1];
+        auto provider = nodes[(size_t)i * 104729 % nodes.size()]->GetOutputPins()[1];
+        receiver->LinkTo(*provider);
+    }
+    auto link_time = ImGui::get_current_time_usec() - start_time;
+
+    size_t found = 0;
+    start_time = ImGui::get_current_time_usec();
+    for (int i = 0; i < ops; i++)
+        found += blueprint.FindPinsLinkedTo(*nodes[(size_t)i * 31 % nodes.size()]->GetOutputPins()[1]).size();
+    auto query_time = ImGui::get_current_time_usec() - start_time;
+
+    // index has to agree with m_LinkFrom which LinkTo/Unlink keep on every provider
+    bool match = true;
+    for (auto pin : blueprint.GetPins())
+        if (blueprint.FindPinsLinkedTo(*pin).size() != pin->m_LinkFrom.size())
+            match = false;
+
+    start_time = ImGui::get_current_time_usec();
+    for (int i = 0; i < ops; i++)
+        nodes[(size_t)i * 7919 % nodes.size()]->GetInputPins()[1]->Unlink();
+    auto unlink_time = ImGui::get_current_time_usec() - start_time;
+
+    printf("link_index: pins=%zu ops=%d link=%.3fus unlink=%.3fus query=%.3fus found=%zu match=%s\n",
+            blueprint.GetPins().size(), ops, (double)link_time / ops, (double)unlink_time / ops,
+            (double)query_time / ops, found, Check(match));
+}
+
+// headless frames need display size and a built font atlas
+static void PrepareFrames()
+{
+    auto& io = ImGui::GetIO();
+    io.DisplaySize = ImVec2(1920, 1080);
+    io.DeltaTime = 1.0f / 60.0f;
+    unsigned char* pixels = nullptr;
+    int width = 0, height = 0;
+    io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);
+}
+
+// one full UI frame on a headless window, returns average frame time in us
+static double RunFrames(BluePrintUI& ui, int frames)
+{
+    auto& io = ImGui::GetIO();
+    auto start_time = ImGui::get_current_time_usec();
+    for (int i = 0; i < frames; i++)
+    {
+        io.DeltaTime = 1.0f / 60.0f;
+        ImGui::NewFrame();
+        ui.Frame();
+        ImGui::Render();
+    }
+    return (double)(ImGui::get_current_time_usec() - start_time) / frames;
+}
+
+// frame: BluePrintUI::Frame of a chain laid out on a grid, default view shows a few dozen nodes.
+// every node drawn against view culling, then zoomed to content with full nodes against rectangles
+static void BenchFrame(int count, int frames)
+{
+    auto editor = ed::GetCurrentEditor();
+    PrepareFrames();
+
+    BluePrintUI ui;
+    ui.Initialize();
+    ed::SetCurrentEditor(ui.m_Editor);
+    bool built = BuildChain(ui.m_Document->m_Blueprint, count);
+    int index = 0;
+    for (auto node : ui.m_Document->m_Blueprint.GetNodes())
+    {
+        ed::SetNodePosition(node->m_ID, ImVec2((index % 50) * 300.f, (index / 50) * 200.f));
+        index++;
+    }
+    ed::SetCurrentEditor(nullptr);
+    if (!built)
+    {
+        BenchFail("frame", "build blueprint");
+        ui.Finalize();
+        ed::SetCurrentEditor(editor);
+        return;
+    }
+
+    // first frames lay out every node so it has a stored size
+    float lod_zoom = ui.m_LodZoom;
+    RunFrames(ui, 2);
+    ui.m_isCullNodes = false;
+    ui.m_LodZoom = 0;
+    auto full_time = RunFrames(ui, frames);
+    ui.m_isCullNodes = true;
+    auto culled_time = RunFrames(ui, frames);
+
+    ed::SetCurrentEditor(ui.m_Editor);
+    ed::NavigateToContent(0.0f);
+    ed::SetCurrentEditor(nullptr);
+    RunFrames(ui, 2);
+    ed::SetCurrentEditor(ui.m_Editor);
+    float zoom = ed::GetCurrentZoom();
+    ed::SetCurrentEditor(nullptr);
+    auto far_full_time = RunFrames(ui, frames);
+    ui.m_LodZoom = lod_zoom;
+    auto far_lod_time = RunFrames(ui, frames);
+    ui.Finalize();
+    ed::SetCurrentEditor(editor);
+
+    auto fps = [](double time) { return time > 0 ? 1000000.0 / time : 0.0; };
+    printf("frame: nodes=%d full=%.3fms(%.0ffps) culled=%.3fms(%.0ffps) zoom=%.2f far_full=%.3fms(%.0ffps) far_lod=%.3fms(%.0ffps)\n",
+            count + 2, full_time / 1000.0, fps(full_time), culled_time / 1000.0, fps(culled_time),
+            zoom, far_full_time / 1000.0, fps(far_full_time), far_lod_time / 1000.0, fps(far_lod_time));
+}
+
+// idle: host loop at 60Hz on an untouched editor for some seconds, flow is shown once in the middle.
+// rendering every tick against rendering only while Frame() asks for it, process cpu time of both
+static void BenchIdle(int count, int seconds)
+{
+    auto editor = ed::GetCurrentEditor();
+    PrepareFrames();
+
+    BluePrintUI ui;
+    ui.Initialize();
+    ed::SetCurrentEditor(ui.m_Editor);
+    bool built = BuildChain(ui.m_Document->m_Blueprint, count);
+    ed::SetCurrentEditor(nullptr);
+    if (!built)
+    {
+        BenchFail("idle", "build blueprint");
+        ui.Finalize();
+        ed::SetCurrentEditor(editor);
+        return;
+    }
+
+    auto& io = ImGui::GetIO();
+    const int ticks = seconds * 60;
+    const int64_t tick_us = 1000000 / 60;
+    auto run = [&](bool on_demand, int& frames)
+    {
+        frames = 0;
+        bool need_update = true;
+        auto last_frame = ImGui::get_current_time_usec();
+        clock_t start_cpu = clock();
+        for (int i = 0; i < ticks; i++)
+        {
+            auto tick_start = ImGui::get_current_time_usec();
+            if (i == ticks / 2)
+            {
+                // stands for a click on Show Flow, a host wakes up on the input event
+                ed::SetCurrentEditor(ui.m_Editor);
+                ui.View_ShowFlow();
+                ed::SetCurrentEditor(nullptr);
+                need_update = true;
+            }
+            if (!on_demand || need_update)
+            {
+                io.DeltaTime = std::max(1e-6f, (tick_start - last_frame) / 1000000.0f);
+                last_frame = tick_start;
+                ImGui::NewFrame();
+                ui.Frame(false, true, true, BluePrintFlag::BluePrintFlag_All, &need_update);
+                ImGui::Render();
+                frames++;
+            }
+            auto spent = ImGui::get_current_time_usec() - tick_start;
+            if (spent < tick_us)
+                std::this_thread::sleep_for(std::chrono::microseconds(tick_us - spent));
+        }
+        return (double)(clock() - start_cpu) / CLOCKS_PER_SEC * 100.0 / seconds;
+    };
+
+    int always_frames = 0, demand_frames = 0;
+    auto always_cpu = run(false, always_frames);
+    auto demand_cpu = run(true, demand_frames);
+    ui.Finalize();
+    ed::SetCurrentEditor(editor);
+
+    printf("idle: nodes=%d seconds=%d always=%d frames cpu=%.1f%% on_demand=%d frames cpu=%.1f%%\n",
+            count + 2, seconds, always_frames, always_cpu, demand_frames, demand_cpu);
+}
+
+// draw count pin icons of every type into list, positions have fractional parts as in node editor
+static void DrawIcons(ImDrawList* drawList, int count)
+{
+    const ImVec2 size(16, 16);
+    for (int i = 0; i < count; i++)
+    {
+        ImVec2 pos((i % 100) * 19.3f, (i / 100) * 18.7f);
+        DrawIcon(drawList, pos, pos + size, (IconType)(i % 9), (i / 9) % 2 == 0,
+                IM_COL32(68, 201, 156, 255), (i / 18) % 2 == 0 ? IM_COL32(32, 32, 32, 255) : 0);
+    }
+}
+
+// icon: frame time of drawing pin icons tessellated every call against stamped from cache,
+//       both ways must give same vertices within subpixel step of the cache
+static void BenchIcon(int count, int frames)
+{
+    PrepareFrames();
+    ImGui::NewFrame();
+    ImDrawList drawList(ImGui::GetDrawListSharedData());
+    drawList.Flags = ImDrawListFlags_AntiAliasedLines | ImDrawListFlags_AntiAliasedLinesUseTex | ImDrawListFlags_AntiAliasedFill | ImDrawListFlags_AllowVtxOffset;
+    auto run = [&](bool cached)
+    {
+        SetIconCacheEnabled(cached);
+        for (int i = 0; i < frames; i++)
+        {
+            drawList._ResetForNewFrame();
+            drawList.PushClipRectFullScreen();
+            drawList.PushTextureID(ImGui::GetIO().Fonts->TexID);
+            DrawIcons(&drawList, count);
+        }
+    };
+
+    ImVector<ImDrawVert> reference;
+    auto ab = MeasureAB([&]() { run(false); }, [&]() { reference = drawList.VtxBuffer; }, [&]() { run(true); });
+    double tessellate_time = (double)ab.m_TimeA / frames, cached_time = (double)ab.m_TimeB / frames;
+    float max_diff = reference.Size == drawList.VtxBuffer.Size ? 0.f : -1.f;
+    bool same_color = reference.Size == drawList.VtxBuffer.Size;
+    for (int i = 0; max_diff >= 0 && i < reference.Size; i++)
+    {
+        auto diff = reference[i].pos - drawList.VtxBuffer[i].pos;
+        max_diff = std::max(max_diff, std::max(fabsf(diff.x), fabsf(diff.y)));
+        same_color = same_color && reference[i].col == drawList.VtxBuffer[i].col;
+    }
+    ImGui::EndFrame();
+
+    printf("icon: icons=%d tessellate=%.3fms cached=%.3fms vtx=%d/%d max_diff=%.3fpx color=%s\n",
+            count, tessellate_time / 1000.0, cached_time / 1000.0, reference.Size, drawList.VtxBuffer.Size,
+            max_diff, Passed(same_color) ? "same" : "differ");
+}
+
+// ----[ suite ]----
+// synthetic graphs, every generator returns entry node of a graph which runs to an exit node
+
+// chain: count x CountNode, N of every node reads Counter of previous one
+static Node* GenerateChain(BP& blueprint, int count)
+{
+    std::vector<Pin*> flow_outs;
+    return BuildNestedChain(blueprint, count, 0, flow_outs);
+}
+
+// fan: Counter of one source node is read by count nodes (fan-out), Exit of all of them
+// goes to one sink node (fan-in), the run walks Completed pins through every node
+static Node* GenerateFan(BP& blueprint, int count)
+{
+    auto entry = blueprint.CreateNode("SystemEntryPointNode");
+    auto source = blueprint.CreateNode("CountNode");
+    auto sink = blueprint.CreateNode("CountNode");
+    auto exit = blueprint.CreateNode("SystemExitPointNode");
+    if (!entry || !source || !sink || !exit)
+        return nullptr;
+    entry->GetOutputPins()[0]->LinkTo(*source->GetInputPins()[0]);
+    Pin* prev = source->GetOutputPins()[2];
+    for (int i = 0; i < count; i++)
+    {
+        auto node = blueprint.CreateNode("CountNode");
+        if (!node)
+            return nullptr;
+        prev->LinkTo(*node->GetInputPins()[0]);
+        node->GetInputPins()[1]->LinkTo(*source->GetOutputPins()[1]);
+        node->GetOutputPins()[0]->LinkTo(*sink->GetInputPins()[0]);
+        prev = node->GetOutputPins()[2];
+    }
+    prev->LinkTo(*exit->GetInputPins()[0]);
+    return entry;
+}
+
+// nested: chain with every node inside 4 nested groups
+static Node* GenerateNested(BP& blueprint, int count)
+{
+    std::vector<Pin*> flow_outs;
+    return BuildNestedChain(blueprint, count, 4, flow_outs);
+}
+
+// loop: LoopNode runs a 4 node body count times, graph stays small while run is long
+static Node* GenerateLoop(BP& blueprint, int count)
+{
+    auto entry = blueprint.CreateNode("SystemEntryPointNode");
+    auto loop = blueprint.CreateNode("LoopNode");
+    auto exit = blueprint.CreateNode("SystemExitPointNode");
+    if (!entry || !loop || !exit)
+        return nullptr;
+    loop->GetInputPins()[2]->SetValue(PinValue(int32_t(count - 1)));
+    entry->GetOutputPins()[0]->LinkTo(*loop->GetInputPins()[0]);
+    Pin* prev = loop->GetOutputPins()[0];
+    for (int i = 0; i < 4; i++)
+    {
+        auto node = blueprint.CreateNode("CountNode");
+        if (!node)
+            return nullptr;
+        prev->LinkTo(*node->GetInputPins()[0]);
+        node->GetInputPins()[1]->LinkTo(*loop->GetOutputPins()[1]);
+        prev = node->GetOutputPins()[2];
+    }
+    loop->GetOutputPins()[2]->LinkTo(*exit->GetInputPins()[0]);
+    return entry;
+}
+
+// mat: filter graph, mat of entry passes to exit while count nodes run in between
+static Node* GenerateMat(BP& blueprint, int count)
+{
+    return BuildFilter(blueprint, count);
+}
+
+// steps of one run, first step is node linked to entry and last one is exit node
+static uint64_t ChainSteps(int count)  { return (uint64_t)count + 1; }
+static uint64_t FanSteps(int count)    { return (uint64_t)count + 2; }  // source runs once, sink never
+// body node i counts to loop index i, loop node runs once more to complete
+static uint64_t LoopSteps(int count)   { return (uint64_t)count + 2 * (uint64_t)count * (count + 1) + 2; }
+
+struct SuiteGraph
+{
+    const char*         m_Name;
+    Node*               (*m_Generate)(BP& blueprint, int count);
+    uint64_t            (*m_Steps)(int count);
+    std::vector<int>    m_Sizes;
+};
+
+// suite: build, save, load, clone and run every synthetic graph at several sizes, quick run
+// takes smallest size only. results are printed and, if results isn't null, appended to it for -j output
+static void BenchSuite(imgui_json::value* results, bool quick)
+{
+    static const SuiteGraph graphs[] =
+    {
+        { "chain",  GenerateChain,  ChainSteps, { 100, 1000, 10000 } },
+        { "fan",    GenerateFan,    FanSteps,   { 100, 1000, 10000 } },
+        { "nested", GenerateNested, ChainSteps, { 100, 1000 } },
+        { "loop",   GenerateLoop,   LoopSteps,  { 100, 1000, 10000 } },
+        { "mat",    GenerateMat,    ChainSteps, { 100, 1000, 10000 } },
+    };
+
+    for (auto& graph : graphs)
+    {
+        for (auto size : graph.m_Sizes)
+        {
+            if (quick && size != graph.m_Sizes.front())
+                break;
+            BP blueprint;
+            auto start_time = ImGui::get_current_time_usec();
+            auto entry = graph.m_Generate(blueprint, size);
+            auto build_time = ImGui::get_current_time_usec() - start_time;
+            if (!entry)
+            {
+                BenchFail("suite", (std::string("build ") + graph.m_Name + " graph").c_str());
+                continue;
+            }
+
+            imgui_json::value value;
+            start_time = ImGui::get_current_time_usec();
+            blueprint.Save(value);
+            auto save_time = ImGui::get_current_time_usec() - start_time;
+
+            BP loaded;
+            start_time = ImGui::get_current_time_usec();
+            bool load_ok = loaded.Load(value) == BP_ERR_NONE;
+            auto load_time = ImGui::get_current_time_usec() - start_time;
+
+            start_time = ImGui::get_current_time_usec();
+            BP cloned(blueprint);
+            auto clone_time = ImGui::get_current_time_usec() - start_time;
+
+            // first run builds lookup indexes, same as in editor after load
+            blueprint.Run(*entry);
+            bool steps_ok = blueprint.GetContext().StepCount() == graph.m_Steps(size);
+            auto steps = std::max(blueprint.GetContext().StepCount(), 1u);
+            int runs = std::max(1, std::min(100, (int)(200000 / steps)));
+            start_time = ImGui::get_current_time_usec();
+            for (int i = 0; i < runs; i++)
+                blueprint.Run(*entry);
+            double run_time = (double)(ImGui::get_current_time_usec() - start_time) / runs;
+
+            auto nodes = blueprint.GetNodes().size();
+            auto pins = blueprint.GetPins().size();
+            printf("suite: graph=%s size=%d nodes=%zu pins=%zu build=%.3fms save=%.3fms load=%.3fms clone=%.3fms run=%.3fms steps=%u/%" PRIu64 " step=%.3fus load_ok=%s steps_ok=%s\n",
+                    graph.m_Name, size, nodes, pins, build_time / 1000.0, save_time / 1000.0, load_time / 1000.0,
+                    clone_time / 1000.0, run_time / 1000.0, steps, graph.m_Steps(size), run_time / steps, Check(load_ok), Check(steps_ok));
+
+            if (results)
+            {
+                imgui_json::value result;
+                result["graph"] = graph.m_Name;
+                result["size"] = imgui_json::number(size);
+                result["nodes"] = imgui_json::number(nodes);
+                result["pins"] = imgui_json::number(pins);
+                result["build_ms"] = imgui_json::number(build_time / 1000.0);
+                result["save_ms"] = imgui_json::number(save_time / 1000.0);
+                result["load_ms"] = imgui_json::number(load_time / 1000.0);
+                result["clone_ms"] = imgui_json::number(clone_time / 1000.0);
+                result["run_ms"] = imgui_json::number(run_time / 1000.0);
+                result["steps"] = imgui_json::number(steps);
+                result["step_us"] = imgui_json::number(run_time / steps);
+                result["load_ok"] = imgui_json::boolean(load_ok);
+                result["steps_ok"] = imgui_json::boolean(steps_ok);
+                results->push_back(result);
+            }
+        }
+    }
+}
+
+int main(int argc, char** argv)
+{
+    std::vector<std::string> plugin_path;
+    std::string json_path;
+    bool suite_only = false;
+    bool quick = false;
+    static struct option long_options[] = {
+        { "plugin_dir", required_argument, NULL, 'p' },
+        { "json", required_argument, NULL, 'j' },
+        { "suite", no_argument, NULL, 's' },
+        { "quick", no_argument, NULL, 'q' },
+        { 0, 0, 0, 0 }
+    };
+    int o = -1;
+    int option_index = 0;
+    while ((o = getopt_long(argc, argv, "p:j:sq", long_options, &option_index)) != -1)
+    {
+        switch (o)
+        {
+            case 'p': plugin_path.push_back(std::string(optarg)); break;
+            case 'j': json_path = std::string(optarg); break;
+            case 's': suite_only = true; break;
+            case 'q': quick = true; break;
+            default: break;
+        }
+    }
+
+    if (!suite_only && !quick)
+    {
+        if (!plugin_path.empty())
+            BenchStartup(plugin_path);
+        else
+            printf("startup: skipped, use -p <plugin_dir>\n");
+    }
+    auto editor = SetupHeadless();
+    if (quick && !suite_only)
+    {
+        // every check at small size, for CTest
+        g_BenchRepeats = 3;
+        BenchCustomPin(16, 256);
+        BenchLoad(500);
+        BenchSave(1000);
+        BenchIncrementalSave(500);
+        BenchClone(500);
+        BenchInstancePool(50);
+        BenchUndo(200, 50);
+        BenchAutoSave(1000, 10);
+        BenchGroupDrag(50, 10);
+        BenchNestedRun(50, 4, 5);
+        BenchImport(50, 10);
+        BenchTrace(50, 5);
+        BenchArena(1000, 2, 2);
+        BenchPinTable(5000, 20);
+        BenchLinkIndex(1000, 500);
+        BenchFrame(200, 5);
+        BenchIcon(1000, 5);
+    }
+    else if (!suite_only)
+    {
+        BenchCustomPin(256, 4096);
+        BenchLoad(1000);
+        BenchLoad(10000);
+        BenchSave(10000);
+        BenchSave(50000);
+        BenchIncrementalSave(5000);
+        BenchClone(1000);
+        BenchClone(10000);
+        BenchInstancePool(500);
+        BenchUndo(1000, 200);
+        BenchAutoSave(20000, 60);
+        BenchGroupDrag(100, 120);
+        BenchGroupDrag(500, 120);
+        BenchNestedRun(200, 0, 50);
+        BenchNestedRun(200, 1, 50);
+        BenchNestedRun(200, 4, 50);
+        BenchNestedRun(200, 16, 50);
+        BenchImport(200, 50);
+        BenchTrace(200, 50);
+        BenchArena(10000, 5, 20);
+        BenchPinTable(50000, 200);
+        BenchLinkIndex(10000, 5000);
+        BenchFrame(500, 30);
+        BenchFrame(1000, 30);
+        BenchFrame(3000, 30);
+        BenchIcon(20000, 30);
+        BenchIdle(1000, 4);
+    }
+
+    imgui_json::value suite = imgui_json::array();
+    BenchSuite(json_path.empty() ? nullptr : &suite, quick);
+    ShutdownHeadless(editor);
+
+    if (!json_path.empty())
+    {
+        int major = 0, minor = 0, patch = 0, build = 0;
+        GetVersion(major, minor, patch, build);
+        imgui_json::value report;
+        report["sdk_version"] = std::to_string(major) + "." + std::to_string(minor) + "." + std::to_string(patch) + "." + std::to_string(build);
+        report["time_stamp"] = imgui_json::number(ImGui::get_current_time_usec() / 1000000);
+        report["suite"] = suite;
+        if (!report.save(json_path))
+        {
+            fprintf(stderr, "suite: write %s failed\n", json_path.c_str());
+            return 1;
+        }
+    }
+    return g_BenchFailures > 0 ? 1 : 0;
+}
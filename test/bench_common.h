@@ -0,0 +1,102 @@
+#pragma once
+#include <UI.h>
+#include <stdio.h>
+#include <utility>
+#include <vector>
+#include <algorithm>
+
+// Shared setup of headless benchmarks, no application window is needed.
+namespace BluePrint
+{
+// pin link and node creation touch node editor state, keep an editor current for the whole run
+static inline ed::EditorContext* SetupHeadless()
+{
+    ImGui::CreateContext();
+    ImGui::GetIO().IniFilename = nullptr;
+    ed::Config config;
+    config.SettingsFile = nullptr;
+    auto editor = ed::CreateEditor(&config);
+    ed::SetCurrentEditor(editor);
+    return editor;
+}
+
+static inline void ShutdownHeadless(ed::EditorContext* editor)
+{
+    ed::SetCurrentEditor(nullptr);
+    ed::DestroyEditor(editor);
+    ImGui::DestroyContext();
+}
+
+// failed checks are counted, main returns non zero when any check of the run failed
+static int g_BenchFailures = 0;
+
+static inline bool Passed(bool ok)
+{
+    if (!ok)
+        g_BenchFailures++;
+    return ok;
+}
+
+static inline const char* Check(bool ok) { return Passed(ok) ? "yes" : "no"; }
+
+static inline void BenchFail(const char* bench, const char* what)
+{
+    fprintf(stderr, "%s: %s failed\n", bench, what);
+    g_BenchFailures++;
+}
+
+// A/B: same work done old way (a) and new way (b), every side is run g_BenchRepeats times
+// and median time in us is kept. prepare_a and prepare_b run untimed before each run of
+// their side, for setup one side needs which must not count on either side
+static int g_BenchRepeats = 5;
+
+struct BenchAB
+{
+    int64_t m_TimeA = 0;
+    int64_t m_TimeB = 0;
+    double Speedup() const { return m_TimeB > 0 ? (double)m_TimeA / (double)m_TimeB : 0.0; }
+};
+
+static inline int64_t Median(std::vector<int64_t> times)
+{
+    if (times.empty())
+        return 0;
+    auto middle = times.begin() + times.size() / 2;
+    std::nth_element(times.begin(), middle, times.end());
+    return *middle;
+}
+
+template <typename PrepareA, typename A, typename PrepareB, typename B>
+static inline BenchAB MeasureAB(PrepareA&& prepare_a, A&& a, PrepareB&& prepare_b, B&& b)
+{
+    std::vector<int64_t> times_a, times_b;
+    for (int i = 0; i < std::max(g_BenchRepeats, 1); i++)
+    {
+        prepare_a();
+        auto start_time = ImGui::get_current_time_usec();
+        a();
+        times_a.push_back(ImGui::get_current_time_usec() - start_time);
+        prepare_b();
+        start_time = ImGui::get_current_time_usec();
+        b();
+        times_b.push_back(ImGui::get_current_time_usec() - start_time);
+    }
+    BenchAB result;
+    result.m_TimeA = Median(std::move(times_a));
+    result.m_TimeB = Median(std::move(times_b));
+    return result;
+}
+
+// between runs untimed after every run of a
+template <typename A, typename Between, typename B>
+static inline BenchAB MeasureAB(A&& a, Between&& between, B&& b)
+{
+    return MeasureAB([]() {}, std::forward<A>(a), std::forward<Between>(between), std::forward<B>(b));
+}
+
+template <typename A, typename B>
+static inline BenchAB MeasureAB(A&& a, B&& b)
+{
+    return MeasureAB([]() {}, std::forward<A>(a), []() {}, std::forward<B>(b));
+}
+} // namespace BluePrint
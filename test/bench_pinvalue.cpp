@@ -0,0 +1,194 @@
+#include <UI.h>
+#include "bench_common.h"
+#include <getopt.h>
+#include <stdio.h>
+
+// Headless micro benchmark for PinValue and pin access, no application window is needed.
+//
+//   bench_pinvalue [-n <iterations>]
+//
+// value: construct, copy, move and assign of PinValue for every variant alternative, destruct
+//        is part of every loop. custom values are only constructed, copy and move of a
+//        PinValueEx* are shallow and would delete the same object twice
+// get_value: Pin::GetValue for every concrete pin class
+// get_pin_value: Context::GetPinValue of an unlinked pin against a linked one
+// get_link: Pin::GetLink with and without blueprint given
+
+using namespace BluePrint;
+
+// every measured loop adds something to it so the compiler can't drop the loop
+static volatile int64_t g_Sink = 0;
+
+// run op iterations times, returns cost of one call in ns
+template <typename F>
+static double Measure(int iterations, F&& op)
+{
+    int64_t sink = 0;
+    auto start_time = ImGui::get_current_time_usec();
+    for (int i = 0; i < iterations; i++)
+        sink += op();
+    auto time = ImGui::get_current_time_usec() - start_time;
+    g_Sink = g_Sink + sink;
+    return (double)time * 1000.0 / (double)iterations;
+}
+
+static void PrintResult(const char* bench, const char* name, double ns)
+{
+    printf("%s: %-12s %8.2fns\n", bench, name, ns);
+}
+
+// value: construct/copy/move/destruct cost of one alternative, make() builds value from
+// source kept outside of the loop, so construct is the cost of PinValue itself
+template <typename F>
+static void BenchValueOf(const char* name, F&& make, int iterations)
+{
+    auto construct_ns = Measure(iterations, [&]() { PinValue value = make(); return (int)value.GetType(); });
+    PinValue value = make();
+    auto copy_ns = Measure(iterations, [&]() { PinValue copy(value); return (int)copy.GetType(); });
+    auto move_ns = Measure(iterations, [&]() { PinValue copy(value); PinValue moved(std::move(copy)); return (int)moved.GetType(); });
+    auto assign_ns = Measure(iterations, [&]() { PinValue copy; copy = value; return (int)copy.GetType(); });
+    printf("value: %-12s construct=%.2fns copy=%.2fns copy+move=%.2fns assign=%.2fns size=%zu\n",
+            name, construct_ns, copy_ns, move_ns, assign_ns, sizeof(PinValue));
+}
+
+static void BenchValue(int iterations)
+{
+    ImGui::ImMat mat;
+    mat.create(64, 64, 4, 1u);
+    imgui_json::array array;
+    for (int i = 0; i < 16; i++)
+        array.push_back(imgui_json::number(i));
+    FlowPin flow(nullptr);
+    std::string long_string(64, 'x');
+
+    BenchValueOf("empty",  []() { return PinValue(); }, iterations);
+    BenchValueOf("flow",   [&]() { return PinValue(&flow); }, iterations);
+    BenchValueOf("bool",   []() { return PinValue(true); }, iterations);
+    BenchValueOf("int32",  []() { return PinValue(int32_t(1)); }, iterations);
+    BenchValueOf("int64",  []() { return PinValue(int64_t(1)); }, iterations);
+    BenchValueOf("float",  []() { return PinValue(1.0f); }, iterations);
+    BenchValueOf("double", []() { return PinValue(1.0); }, iterations);
+    BenchValueOf("string", []() { return PinValue("short"); }, iterations);
+    BenchValueOf("string_long", [&]() { return PinValue(long_string); }, iterations);
+    BenchValueOf("point",  []() { return PinValue(uintptr_t(1)); }, iterations);
+    BenchValueOf("vec2",   []() { return PinValue(ImVec2(1, 1)); }, iterations);
+    BenchValueOf("vec4",   []() { return PinValue(ImVec4(1, 1, 1, 1)); }, iterations);
+    BenchValueOf("mat",    [&]() { return PinValue(mat); }, iterations);
+    BenchValueOf("array",  [&]() { return PinValue(array); }, iterations);
+
+    // PinValue(PinValueEx*) copies held value, destructor deletes the copy. Named lvalue picks
+    // that overload, a temporary pointer could bind to the taking one and delete stack object
+    PinValueExImpl<int> custom(new int(1));
+    PinValueEx* custom_ex = &custom;
+    PrintResult("value", "custom", Measure(iterations, [&]() { PinValue value(custom_ex); return (int)value.GetType(); }));
+}
+
+// custom pin needs a registered PinEx type
+class BenchPinEx : public PinEx
+{
+public:
+    const PinTypeEx& GetTypeEx() const override { static PinTypeEx type("BenchPinEx"); return type; }
+    void SetValuePtr(void* valuePtr, const std::type_info& typeInfo) override {}
+};
+
+// get_value: virtual GetValue of every concrete pin class, result is destructed in the loop
+static void BenchGetValue(Node* node, int iterations)
+{
+    static PinExModuleInfo type_info { PinTypeEx("BenchPinEx"), 0, []() -> PinEx* { return new BenchPinEx(); } };
+    static auto registered = BP::GetPinExRegistry()->RegisterPinEx(&type_info);
+    if (!registered)
+    {
+        BenchFail("get_value", "register pin type");
+        return;
+    }
+
+    ImGui::ImMat mat;
+    mat.create(64, 64, 4, 1u);
+    imgui_json::array array;
+    for (int i = 0; i < 16; i++)
+        array.push_back(imgui_json::number(i));
+
+    std::vector<std::pair<const char*, std::unique_ptr<Pin>>> pins;
+    pins.emplace_back("flow",   new FlowPin(node));
+    pins.emplace_back("any",    new AnyPin(node));
+    pins.emplace_back("bool",   new BoolPin(node, true));
+    pins.emplace_back("int32",  new Int32Pin(node, 1));
+    pins.emplace_back("int64",  new Int64Pin(node, 1));
+    pins.emplace_back("float",  new FloatPin(node, 1.0f));
+    pins.emplace_back("double", new DoublePin(node, 1.0));
+    pins.emplace_back("string", new StringPin(node, "String", std::string(64, 'x')));
+    pins.emplace_back("point",  new PointPin(node, uintptr_t(1)));
+    pins.emplace_back("vec2",   new Vec2Pin(node, ImVec2(1, 1)));
+    pins.emplace_back("vec4",   new Vec4Pin(node, ImVec4(1, 1, 1, 1)));
+    pins.emplace_back("array",  new ArrayPin(node, array));
+    pins.emplace_back("mat",    new MatPin(node, mat));
+    pins.emplace_back("custom", new CustomPin(node, "BenchPinEx"));
+
+    for (auto& pin : pins)
+    {
+        Pin* p = pin.second.get();
+        PrintResult("get_value", pin.first, Measure(iterations, [p]() { return (int)p->GetValue().GetType(); }));
+    }
+}
+
+// get_pin_value/get_link: N of a CountNode read while unlinked and linked to Counter of another one
+static void BenchPinAccess(BP& blueprint, int iterations)
+{
+    auto source = blueprint.CreateNode("CountNode");
+    auto linked = blueprint.CreateNode("CountNode");
+    auto unlinked = blueprint.CreateNode("CountNode");
+    if (!source || !linked || !unlinked)
+    {
+        BenchFail("get_pin_value", "create node");
+        return;
+    }
+    Pin* linked_pin = linked->GetInputPins()[1];
+    Pin* unlinked_pin = unlinked->GetInputPins()[1];
+    if (!linked_pin->LinkTo(*source->GetOutputPins()[1]))
+    {
+        BenchFail("get_pin_value", "link");
+        return;
+    }
+
+    auto& context = blueprint.GetContext();
+    PrintResult("get_pin_value", "unlinked", Measure(iterations, [&]() { return (int)context.GetPinValue(*unlinked_pin).GetType(); }));
+    PrintResult("get_pin_value", "linked", Measure(iterations, [&]() { return (int)context.GetPinValue(*linked_pin).GetType(); }));
+
+    const BP* bp = &blueprint;
+    PrintResult("get_link", "node_bp", Measure(iterations, [&]() { return linked_pin->GetLink() ? 1 : 0; }));
+    PrintResult("get_link", "given_bp", Measure(iterations, [&]() { return linked_pin->GetLink(bp) ? 1 : 0; }));
+    PrintResult("get_link", "unlinked", Measure(iterations, [&]() { return unlinked_pin->GetLink() ? 1 : 0; }));
+}
+
+int main(int argc, char** argv)
+{
+    int iterations = 1000000;
+    static struct option long_options[] = {
+        { "iterations", required_argument, NULL, 'n' },
+        { 0, 0, 0, 0 }
+    };
+    int o = -1;
+    int option_index = 0;
+    while ((o = getopt_long(argc, argv, "n:", long_options, &option_index)) != -1)
+    {
+        switch (o)
+        {
+            case 'n': iterations = std::max(1, atoi(optarg)); break;
+            default: break;
+        }
+    }
+
+    auto editor = SetupHeadless();
+    BenchValue(iterations);
+    {
+        BP blueprint;
+        auto node = blueprint.CreateNode("DummyNode");
+        if (node)
+            BenchGetValue(node, iterations);
+        else
+            BenchFail("get_value", "create node");
+        BenchPinAccess(blueprint, iterations);
+    }
+    ShutdownHeadless(editor);
+    return g_BenchFailures > 0 ? 1 : 0;
+}